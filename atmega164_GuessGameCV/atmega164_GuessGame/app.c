@@ -0,0 +1,561 @@
+/*
+ * app.c
+ *
+ * Menu, game and text pages: a PROGMEM page table routes button events and redraws to the open page.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+
+#include "app.h"
+#include "bench.h"
+#include "display.h"
+#include "game.h"
+#include "graphics.h"
+#include "input.h"
+#include "random.h"
+#include "store.h"
+#include "text.h"
+#include "telemetry.h"
+#include "timer.h"
+#include "uart.h"
+
+// Strings shared by several pages
+// A space is 3 columns and an arrow 4, the spaces put the arrows above the keys
+const char TXT_NAV[] PROGMEM = "    <     ^     v      >";
+const char TXT_BACK[] PROGMEM = "    <";
+const char TXT_STRIKES[] PROGMEM = "Strikes:";
+
+// Menu entries with the selection marker, printed from the second character when not selected
+const char TXT_MENU_GAME[] PROGMEM = ">1. Start Game";
+const char TXT_MENU_HOWTOPLAY[] PROGMEM = ">2. How To Play";
+const char TXT_MENU_ABOUT[] PROGMEM = ">3. About";
+
+PGM_P const TXT_MENU[] PROGMEM =
+{
+	TXT_MENU_GAME,
+	TXT_MENU_HOWTOPLAY,
+	TXT_MENU_ABOUT,
+};
+
+// Page opened by each menu entry
+const unsigned char MENU_PAGES[] PROGMEM = { PAGE_GAME, PAGE_HOWTOPLAY, PAGE_ABOUT };
+#define MENU_ENTRIES (sizeof(MENU_PAGES))
+
+// Paragraphs are wrapped to the screen width when the page is opened, '\n' starts a new line
+const char TXT_ABOUT[] PROGMEM =
+	"A game where you must guess the word. This software was written by Emma Savu\n"
+	"group 1242 EB\n"
+	"from FILS.";
+
+const char TXT_HOWTOPLAY[] PROGMEM =
+	"Controls: Use the up and down keys to select a letter and confirm the selection "
+	"with the right key.\n"
+	"Rules: You must guess the word by selecting the letters which occur in the word. "
+	"Each selection reveals part of the word and when the whole word is revealed, you win. "
+	"If you guess incorrectly then you will receive a strike. The 3rd strike results in a loss.";
+
+// Open page and its handlers, copied out of PAGES so dispatching is one indirect call
+Page page;
+unsigned char pageIndex = PAGE_NONE;
+unsigned char pageScroll = 0;       // Menu selection, alphabet cursor or first text line, depending on the page
+unsigned char pageScrollMax = 0;
+bool pageDirty = false;
+unsigned char pageTickTask = TASK_MAX;
+
+// Frame governor: a page is drawn only after something marked it dirty, and at most FRAME_FPS_MAX times a second
+#ifndef FRAME_FPS_MAX
+#define FRAME_FPS_MAX 50
+#endif
+#define FRAME_MIN_MS (1000 / FRAME_FPS_MAX)
+unsigned int frameLast = 0 - FRAME_MIN_MS;     // Tick of the last render, the first frame may go at once
+unsigned int framesRendered = 0;
+unsigned int framesSkipped = 0;                 // Changes folded into a frame that was already waiting
+
+// Something the open page shows changed, it is drawn once the frame rate allows
+void PageInvalidate()
+{
+	if(pageDirty)
+	{
+		framesSkipped++;
+	}
+	pageDirty = true;
+}
+
+// A dirty page may be drawn now
+bool FrameDue()
+{
+	return pageDirty && ((unsigned int)(TickNow() - frameLast) >= FRAME_MIN_MS);
+}
+
+// Menu selection kept while another page is open
+unsigned char menuSelection = 0;
+
+// Game state
+Game game;
+bool generate = true;
+bool gamePlayed = false;        // game holds a round (the current one or the one the result page shows)
+unsigned int gamesWon = 0;
+unsigned int gamesLost = 0;
+
+// Saving: changes are collected for SAVE_DELAY_MS after the last one, then written in the background
+#define SAVE_DELAY_MS 1000
+unsigned char saveTask = TASK_MAX;
+
+// Write the state to EEPROM, a record still being written makes it try again later
+void SaveNow()
+{
+	StoreRecord record;
+	saveTask = TASK_MAX;
+	record.page = pageIndex;
+	record.scroll = pageScroll;
+	record.menu = menuSelection;
+	record.word = gamePlayed ? game.index : STORE_NO_WORD;
+	record.guessed = game.guessed;
+	record.strikes = game.strikes;
+	record.flags = generate ? STORE_NEW_WORD : 0;
+	record.wins = gamesWon;
+	record.losses = gamesLost;
+	if(!StoreWrite(&record))
+	{
+		saveTask = TimerStart(SAVE_DELAY_MS, SaveNow);
+	}
+}
+
+// Something worth keeping changed, the save waits until nothing changed for SAVE_DELAY_MS
+void SaveRequest()
+{
+	TaskCancel(saveTask);
+	saveTask = TimerStart(SAVE_DELAY_MS, SaveNow);
+}
+
+// 1: words come from a shuffle bag, none repeats until every word was played, 0: independent draws
+#ifndef WORD_SHUFFLE
+#define WORD_SHUFFLE 1
+#endif
+#if WORD_SHUFFLE
+ShuffleBag wordBag;
+#endif
+
+// Alphabet selector: A-P on bank 3 and Q-Z on bank 4, one 5 pixel cell per letter
+#define ALPHABET_ROW 3
+#define ALPHABET_PER_ROW 16
+#define CURSOR_HIDDEN 0xFF
+// Strike boxes on bank 0, right of the 8 character label
+#define STRIKE_BOX_X 36
+#define STRIKE_BOX_STEP 8
+#define STRIKE_BOX_SIZE 6
+// Letter highlighted on the screen, CURSOR_HIDDEN when the game board has to be drawn in full
+unsigned char cursorShown = CURSOR_HIDDEN;
+
+// Invert the cell of a letter in the alphabet selector, inverting it again removes the highlight
+void InvertLetterCell(unsigned char index)
+{
+	unsigned char col = (index % ALPHABET_PER_ROW) * 5;
+	DisplayInvert(ALPHABET_ROW + index / ALPHABET_PER_ROW, col ? (col - 1) : 0, col + 4);
+}
+
+// Wake-to-render latency: from the pin change that woke the CPU to the end of the redraw it caused
+// Debouncing takes DEBOUNCE_MS of that, a full redraw and flush fits in the rest
+#define WAKE_LATENCY_LIMIT_MS (DEBOUNCE_MS + 15)
+unsigned int wakeLatencyLast = 0;
+unsigned int wakeLatencyMax = 0;
+unsigned int wakeLatencyOverruns = 0;
+
+// Menu: the selection comes back when returning to it
+void MenuEnter()
+{
+	pageScroll = menuSelection;
+}
+
+void MenuRender()
+{
+	unsigned char i;
+	PGM_P entry;
+	DisplayClear();
+	for(i = 0; i < MENU_ENTRIES; i++)
+	{
+		entry = (PGM_P)pgm_read_ptr(&TXT_MENU[i]);
+		DisplayPrintLine_P(i, 0, (i == pageScroll) ? entry : (entry + 1));
+	}
+	DisplayPrintLine_P(5,0,PSTR("          ^     v      >"));
+}
+
+void MenuInput(unsigned char key)
+{
+	if(key == P_RGT)
+	{
+		menuSelection = pageScroll;
+		PageOpen(pgm_read_byte(&MENU_PAGES[pageScroll]));
+	}
+}
+
+// Game: a new word after the last round ended, otherwise the round goes on where it was left
+void GameEnter()
+{
+	unsigned int randNum;
+	if(generate)
+	{
+		// When the player starts is random too: TickNow only counts awake time (Timer0 stops in power-down),
+		// but how long keys were held and debounced before this press still varies from game to game
+		RandomStir(TickNow() ^ entropyPool);
+#if WORD_SHUFFLE
+		randNum = BagNext(&wordBag);
+#else
+		randNum = RandomBelow(DictCount());
+#endif
+		GameStart(&game, randNum);
+		generate = false;
+		gamePlayed = true;
+	}
+}
+
+void GameRender()
+{
+	unsigned char i;
+	BENCH_BEGIN(BENCH_GAME);
+	if(cursorShown != CURSOR_HIDDEN)
+	{
+		// Only the cursor moved, the letters stay where they are
+		InvertLetterCell(cursorShown);
+		InvertLetterCell(pageScroll);
+		cursorShown = pageScroll;
+	}
+	else
+	{
+		unsigned long mask;
+		char letter;
+		char shown[WORD_MAX + 1];
+		DisplayClear();
+		// One box per strike after the label, filled once the strike was taken
+		DisplayPrintLine_P(0,0, TXT_STRIKES);
+		for(i = 0; i < STRIKES_MAX; i++)
+		{
+			if(i < game.strikes)
+			{
+				GfxRect(STRIKE_BOX_X + i * STRIKE_BOX_STEP, 1, STRIKE_BOX_SIZE, STRIKE_BOX_SIZE, GFX_SET);
+			}
+			else
+			{
+				GfxFrame(STRIKE_BOX_X + i * STRIKE_BOX_STEP, 1, STRIKE_BOX_SIZE, STRIKE_BOX_SIZE, GFX_SET);
+			}
+		}
+		// Revealed word, twice as large over banks 1 and 2 when it fits
+		for(i = 0; i < game.length; i++)
+		{
+			letter = game.word[i];
+			shown[i] = (game.guessed & LETTER_BIT(letter)) ? letter : '_';
+		}
+		shown[i] = '\0';
+		if(DisplayPrintLarge(1, shown, 2) == 1)
+		{
+			// Guessed letters in alphabetical order below a word in the small font
+			for(i = 0, letter = 'A', mask = game.guessed; mask != 0; letter++, mask >>= 1)
+			{
+				if(mask & 1)
+				{
+					DisplayPrintChar(2, i++, letter);
+				}
+			}
+		}
+		// Alphabet in fixed cells with the selected letter inverted
+		for(i = 0; i < 26; i++)
+		{
+			DisplayPrintChar(ALPHABET_ROW + i / ALPHABET_PER_ROW, i % ALPHABET_PER_ROW, 'A' + i);
+		}
+		InvertLetterCell(pageScroll);
+		cursorShown = pageScroll;
+		DisplayPrintLine_P(5,0,TXT_NAV);
+	}
+	BENCH_END(BENCH_GAME);
+}
+
+void GameInput(unsigned char key)
+{
+	if(key == P_RGT)
+	{
+		GameGuess(&game, 'A' + pageScroll);
+		SaveRequest();
+		if(GameWon(&game) || GameLost(&game))
+		{
+			if(GameWon(&game))
+			{
+				gamesWon++;
+			}
+			else
+			{
+				gamesLost++;
+			}
+			generate = true;
+			menuSelection = 0;
+			PageOpen(GameWon(&game) ? PAGE_WON : PAGE_LOST);
+		}
+		else
+		{
+			cursorShown = CURSOR_HIDDEN;     // The guess changes more than the cursor
+			PageInvalidate();
+		}
+	}
+}
+
+// Text pages: the paragraph is laid out once, the scroll range is its line count less the visible lines
+#define TEXT_ROWS 5
+
+void TextPageEnter()
+{
+	unsigned char lines = TextLayout(page.text);
+	pageScrollMax = (lines > TEXT_ROWS) ? (lines - TEXT_ROWS) : 0;
+}
+
+void TextPageRender()
+{
+	TextShow(pageScroll, TEXT_ROWS);     // Scrolling by one line only draws the new line
+	DisplayPrintLine_P(5,0,TXT_NAV);
+}
+
+// Write value in decimal at out and return the end of the digits (not terminated)
+char* FormatNumber(char* out, unsigned int value)
+{
+	char digits[5];
+	unsigned char count = 0;
+	do
+	{
+		digits[count++] = '0' + value % 10;
+		value /= 10;
+	} while(value != 0);
+	while(count != 0)
+	{
+		*out++ = digits[--count];
+	}
+	return out;
+}
+
+// Games won and lost so far on bank 0
+void StatsRender()
+{
+	char digits[sizeof("65535")];
+	unsigned char x;
+	*FormatNumber(digits, gamesWon) = '\0';
+	x = DisplayPrint_P(0, 0, PSTR("Won "));     // Labels straight from flash, only the numbers go through RAM
+	x = DisplayPrint(0, x, digits);
+	*FormatNumber(digits, gamesLost) = '\0';
+	x = DisplayPrint_P(0, x, PSTR(" Lost "));
+	DisplayPrint(0, x, digits);
+}
+
+// Result pages after a round
+void WonRender()
+{
+	DisplayClear();
+	StatsRender();
+	DisplayPrintLine_P(1,5,PSTR("You Won!"));
+	DisplayPrintLarge(2, game.word, 3);
+	DisplayPrintLine_P(5,0,TXT_BACK);
+}
+
+void LostRender()
+{
+	DisplayClear();
+	StatsRender();
+	DisplayPrintLine_P(1,4,PSTR("You Lost!"));
+	DisplayPrintLarge(2, game.word, 3);     // The word that was not found
+	DisplayPrintLine_P(5,0,TXT_BACK);
+}
+
+// Every page, in PAGE_ id order
+const Page PAGES[PAGE_COUNT] PROGMEM =
+{
+	// enter          render           input       tick  text             scrollMax  back
+	{ MenuEnter,      MenuRender,      MenuInput,  NULL, NULL,            2,         PAGE_NONE },
+	{ GameEnter,      GameRender,      GameInput,  NULL, NULL,            25,        PAGE_MENU },
+	{ TextPageEnter,  TextPageRender,  NULL,       NULL, TXT_HOWTOPLAY,   0,         PAGE_MENU },
+	{ TextPageEnter,  TextPageRender,  NULL,       NULL, TXT_ABOUT,       0,         PAGE_MENU },
+	{ NULL,           WonRender,       NULL,       NULL, NULL,            0,         PAGE_MENU },
+	{ NULL,           LostRender,      NULL,       NULL, NULL,            0,         PAGE_MENU },
+};
+
+// Switch to another page: its table entry is copied in, the scroll starts at 0 and the screen is redrawn in full
+void PageOpen(unsigned char index)
+{
+	if(pageTickTask != TASK_MAX)
+	{
+		TaskCancel(pageTickTask);
+		pageTickTask = TASK_MAX;
+	}
+	memcpy_P(&page, &PAGES[index], sizeof(Page));
+	pageIndex = index;
+	pageScroll = 0;
+	pageScrollMax = page.scrollMax;
+	TextHide();                         // What the last page left on the screen can't be reused
+	cursorShown = CURSOR_HIDDEN;
+	if(page.enter != NULL)
+	{
+		page.enter();
+	}
+	if(page.tick != NULL)
+	{
+		pageTickTask = TaskAdd(page.tick, PAGE_TICK_MS, PAGE_TICK_MS);
+	}
+	PageInvalidate();
+	SaveRequest();
+}
+
+// Apply one button event to the open page: up/down move the scroll inside its range (held keys repeat),
+// left goes back and the other keys go to the page's own handler once per press
+void HandleInput(unsigned char event)
+{
+	unsigned char key = event & EVENT_KEY_MASK;
+	unsigned char type = event & EVENT_TYPE_MASK;
+	if((type == EVENT_RELEASE) || ((type == EVENT_REPEAT) && (key != P_UP) && (key != P_DWN)))
+	{
+		return;
+	}
+	if(key == P_UP)
+	{
+		if(pageScroll > 0)
+		{
+			pageScroll--;
+			PageInvalidate();
+			SaveRequest();
+		}
+	}
+	else if(key == P_DWN)
+	{
+		if(pageScroll < pageScrollMax)
+		{
+			pageScroll++;
+			PageInvalidate();
+			SaveRequest();
+		}
+	}
+	else if((key == P_LFT) && (page.back != PAGE_NONE))
+	{
+		PageOpen(page.back);
+	}
+	else if(page.input != NULL)
+	{
+		page.input(key);
+	}
+}
+
+// Bring back the round, the statistics and the page with its scroll from the last save, or open the menu
+// The page is opened once with everything in place, so the screen is drawn a single time
+void AppRestore()
+{
+	StoreRecord saved;
+	unsigned char index = PAGE_MENU;
+	unsigned char scroll = 0;
+	if(StoreLoad(&saved))
+	{
+		gamesWon = saved.wins;
+		gamesLost = saved.losses;
+		menuSelection = (saved.menu < MENU_ENTRIES) ? saved.menu : 0;
+		if(saved.word < DictCount())
+		{
+			GameStart(&game, saved.word);
+			game.guessed = saved.guessed & game.letters;
+			game.strikes = saved.strikes;
+			generate = (saved.flags & STORE_NEW_WORD) != 0;
+			gamePlayed = true;
+		}
+		if((saved.page < PAGE_COUNT) && (gamePlayed || ((saved.page != PAGE_WON) && (saved.page != PAGE_LOST))))
+		{
+			index = saved.page;
+			scroll = saved.scroll;
+		}
+	}
+	PageOpen(index);
+	if(scroll <= pageScrollMax)
+	{
+		pageScroll = scroll;
+	}
+	TaskCancel(saveTask);       // Nothing changed yet
+	saveTask = TASK_MAX;
+}
+
+// Set up the hardware and the tasks (interrupts are enabled by the caller)
+void AppInit()
+{
+	initInput();
+	DisplayInit();
+	TickInit();
+	EntropyInit();
+#ifdef TELEMETRY
+	TelemetryInit();
+#endif
+#if WORD_SHUFFLE
+	BagInit(&wordBag, DictCount());
+#endif
+	AppRestore();
+}
+
+// One pass of the main loop: handle the queued button events, run the due tasks and redraw if anything changed
+void AppRun()
+{
+	unsigned char event;
+	bool handled = false;
+	while(EventGet(&event))
+	{
+		BENCH_BEGIN(BENCH_INPUT);
+		HandleInput(event);
+		BENCH_END(BENCH_INPUT);
+		handled = true;
+	}
+	SchedulerRun();
+	if(FrameDue())
+	{
+		pageDirty = false;
+		frameLast = TickNow();
+		framesRendered++;
+		BENCH_BEGIN(BENCH_RENDER);
+		page.render();
+		BENCH_END(BENCH_RENDER);
+		if(handled && wakePending)
+		{
+			wakeLatencyLast = TickNow() - wakeTick;
+			if(wakeLatencyLast > wakeLatencyMax)
+			{
+				wakeLatencyMax = wakeLatencyLast;
+			}
+			if(wakeLatencyLast > WAKE_LATENCY_LIMIT_MS)
+			{
+				wakeLatencyOverruns++;
+			}
+		}
+#ifdef TELEMETRY
+		// Input, game and render of this frame plus the display bytes sent since the last one, and the wake latency
+		TelemetryFrame(framesRendered, framesSkipped, wakeLatencyLast, wakeLatencyMax, wakeLatencyOverruns);
+#endif
+	}
+	if(handled)
+	{
+		wakePending = false;    // A press that changed nothing on screen has no latency to measure
+	}
+	DisplayFlush();     // Starts sending the changed banks, a flush still running leaves them for a later pass
+}
+
+// Deepest sleep mode allowed right now, APP_AWAKE while there is still work (call with interrupts disabled)
+unsigned char AppSleepMode()
+{
+	if(FrameDue() || EventPending() || (DisplayDirty() && !DisplayBusy()))
+	{
+		return APP_AWAKE;
+	}
+	if(pageDirty || buttonScan || SchedulerPending() || DisplayBusy() || StoreBusy())
+	{
+		return SLEEP_MODE_IDLE;         // Timer0 keeps ticking for a held back frame, the debounce scan and the timers (a save waiting among them), SPI for the flush, the EEPROM ready interrupt for a save
+	}
+	if(EntropyBusy())
+	{
+		return SLEEP_MODE_IDLE;         // The watchdog samples TCNT0, which only counts while Timer0 runs (the first 0.5 s after boot)
+	}
+#ifdef TELEMETRY
+	if(UartBusy())
+	{
+		return SLEEP_MODE_IDLE;         // The USART clock stops in power-down
+	}
+#endif
+	return SLEEP_MODE_PWR_DOWN;         // Only a button pin change can make more work
+}
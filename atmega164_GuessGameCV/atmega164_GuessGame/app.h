@@ -0,0 +1,53 @@
+/*
+ * app.h
+ *
+ * Menu, game and text pages.
+ */
+
+#ifndef APP_H_
+#define APP_H_
+
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+
+// AppSleepMode() result when the main loop must not sleep
+#define APP_AWAKE 0xFF
+
+// Page ids, the index into PAGES
+#define PAGE_MENU      0
+#define PAGE_GAME      1
+#define PAGE_HOWTOPLAY 2
+#define PAGE_ABOUT     3
+#define PAGE_WON       4
+#define PAGE_LOST      5
+#define PAGE_COUNT     6
+#define PAGE_NONE      0xFF
+
+// How often the tick handler of the open page runs
+#define PAGE_TICK_MS 100
+
+// One page: every handler may be NULL except render, up/down/left are handled by the table itself
+typedef struct
+{
+    void (*enter)();                // Page opened, after the scroll was reset (may change pageScrollMax)
+    void (*render)();               // Draw into the framebuffer, only called after something changed
+    void (*input)(unsigned char key);   // Press of a key other than up, down and (with a back page) left
+    void (*tick)();                 // Every PAGE_TICK_MS while the page is open
+    PGM_P text;                     // Page data, e.g. the paragraph of a text page
+    unsigned char scrollMax;        // Up/down move the scroll between 0 and this
+    unsigned char back;             // Page the left key opens, PAGE_NONE to give left to the input handler
+} Page;
+
+extern unsigned int framesRendered;
+extern unsigned int framesSkipped;
+extern unsigned int wakeLatencyLast;
+extern unsigned int wakeLatencyMax;
+extern unsigned int wakeLatencyOverruns;
+
+void PageInvalidate();
+void PageOpen(unsigned char index);
+void AppInit();
+void AppRun();
+unsigned char AppSleepMode();
+
+#endif /* APP_H_ */
@@ -0,0 +1,38 @@
+/*
+ * bench.h
+ *
+ * Section markers for the simavr benchmark (see bench/). A marker is one
+ * write to GPIOR0 that the simulator watches, so it costs a single out
+ * instruction and nothing at all unless BENCH is defined. With TELEMETRY
+ * the same markers feed the on-device cycle counters instead.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+// Section ids (bench/bench.c has the matching names)
+#define BENCH_INPUT      1      // HandleInput for one event
+#define BENCH_RENDER     2      // render hook of the open page, called by AppRun
+#define BENCH_GAME       3      // GameRender, the game page's render hook
+#define BENCH_CLEAR      4      // DisplayClear
+#define BENCH_PRINT_LINE 5      // DisplayPrintLine
+#define BENCH_FLUSH      6      // DisplayFlush
+#define BENCH_SPI_ISR    7      // Body of the SPI complete interrupt of the background flush (DISPLAY_ISR_FLUSH)
+
+#define BENCH_END_FLAG   0x80
+
+#ifdef BENCH
+#include <avr/io.h>
+#define BENCH_BEGIN(id) (GPIOR0 = (id))
+#define BENCH_END(id)   (GPIOR0 = BENCH_END_FLAG | (id))
+#elif defined(TELEMETRY)
+#include "telemetry.h"
+// Timer1 cycle counters sent over the UART, for the sections the frame has room for
+#define BENCH_BEGIN(id) (((id) <= TELEMETRY_SECTIONS) ? ProfileBegin(id) : (void)0)
+#define BENCH_END(id)   (((id) <= TELEMETRY_SECTIONS) ? ProfileEnd(id) : (void)0)
+#else
+#define BENCH_BEGIN(id) ((void)0)
+#define BENCH_END(id)   ((void)0)
+#endif
+
+#endif /* BENCH_H_ */
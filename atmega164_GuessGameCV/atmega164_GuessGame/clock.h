@@ -0,0 +1,96 @@
+/*
+ * clock.h
+ *
+ * Timer, UART and SPI settings worked out from F_CPU at compile time.
+ */
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+#include "config.h"
+
+// Largest error allowed between a requested rate and what the dividers can give, in 1/1000
+#define CLOCK_TICK_ERROR   10   // 1 %, nothing here keeps time over hours
+#define CLOCK_BAUD_ERROR   20   // 2 %, what a UART receiver tolerates
+
+// System tick: Timer0 in CTC mode, the smallest prescaler that fits the period in 8 bits gives the finest OCR
+#define TICK_HZ 1000UL
+#if (F_CPU / 1 / TICK_HZ) <= 256
+#define TICK_PRESCALER 1UL
+#define TICK_CS (1 << CS00)
+#elif (F_CPU / 8 / TICK_HZ) <= 256
+#define TICK_PRESCALER 8UL
+#define TICK_CS (1 << CS01)
+#elif (F_CPU / 64 / TICK_HZ) <= 256
+#define TICK_PRESCALER 64UL
+#define TICK_CS ((1 << CS01) | (1 << CS00))
+#elif (F_CPU / 256 / TICK_HZ) <= 256
+#define TICK_PRESCALER 256UL
+#define TICK_CS (1 << CS02)
+#else
+#define TICK_PRESCALER 1024UL
+#define TICK_CS ((1 << CS02) | (1 << CS00))
+#endif
+#define TICK_COUNTS ((F_CPU + TICK_PRESCALER * TICK_HZ / 2) / (TICK_PRESCALER * TICK_HZ))     // Rounded
+#define TICK_OCR (TICK_COUNTS - 1)
+// Real tick rate in mHz
+#define TICK_ACTUAL_MHZ ((F_CPU * 1000UL) / (TICK_PRESCALER * TICK_COUNTS))
+
+#if (TICK_COUNTS < 2) || (TICK_COUNTS > 256)
+#error "F_CPU out of range for a 1 ms Timer0 tick"
+#elif (TICK_ACTUAL_MHZ > TICK_HZ * (1000 + CLOCK_TICK_ERROR)) || (TICK_ACTUAL_MHZ < TICK_HZ * (1000 - CLOCK_TICK_ERROR))
+#error "F_CPU can't make a 1 ms tick within CLOCK_TICK_ERROR"
+#endif
+
+// USART0 in double speed mode (U2X0), rounded to the nearest divider
+#define UBRRVAL (((F_CPU + BAUDRATE * 4UL) / (BAUDRATE * 8UL)) - 1)
+#define BAUD_ACTUAL (F_CPU / (8UL * (UBRRVAL + 1)))
+
+// Only builds that use the UART have to meet it
+#ifdef TELEMETRY
+#if ((F_CPU + BAUDRATE * 4UL) / (BAUDRATE * 8UL)) < 1
+#error "BAUDRATE too high for F_CPU"
+#elif (UBRRVAL > 4095)
+#error "BAUDRATE too low for F_CPU"
+#elif (BAUD_ACTUAL * 1000UL > BAUDRATE * (1000UL + CLOCK_BAUD_ERROR)) || (BAUD_ACTUAL * 1000UL < BAUDRATE * (1000UL - CLOCK_BAUD_ERROR))
+#error "F_CPU can't make BAUDRATE within CLOCK_BAUD_ERROR"
+#endif
+#endif
+
+// Display SPI: the fastest clock the PCD8544 takes (4 MHz) unless a slower one is asked for, as SPCR/SPSR bits
+#ifndef DISPLAY_SPI_MAX_HZ
+#define DISPLAY_SPI_MAX_HZ 4000000UL
+#endif
+#if (F_CPU / 2) <= DISPLAY_SPI_MAX_HZ
+#define SPI_DIVIDER 2
+#define SPI_SPCR_BITS 0
+#define SPI_SPSR_BITS (1 << SPI2X)
+#elif (F_CPU / 4) <= DISPLAY_SPI_MAX_HZ
+#define SPI_DIVIDER 4
+#define SPI_SPCR_BITS 0
+#define SPI_SPSR_BITS 0
+#elif (F_CPU / 8) <= DISPLAY_SPI_MAX_HZ
+#define SPI_DIVIDER 8
+#define SPI_SPCR_BITS (1 << SPR0)
+#define SPI_SPSR_BITS (1 << SPI2X)
+#elif (F_CPU / 16) <= DISPLAY_SPI_MAX_HZ
+#define SPI_DIVIDER 16
+#define SPI_SPCR_BITS (1 << SPR0)
+#define SPI_SPSR_BITS 0
+#elif (F_CPU / 32) <= DISPLAY_SPI_MAX_HZ
+#define SPI_DIVIDER 32
+#define SPI_SPCR_BITS (1 << SPR1)
+#define SPI_SPSR_BITS (1 << SPI2X)
+#elif (F_CPU / 64) <= DISPLAY_SPI_MAX_HZ
+#define SPI_DIVIDER 64
+#define SPI_SPCR_BITS (1 << SPR1)
+#define SPI_SPSR_BITS 0
+#elif (F_CPU / 128) <= DISPLAY_SPI_MAX_HZ
+#define SPI_DIVIDER 128
+#define SPI_SPCR_BITS ((1 << SPR1) | (1 << SPR0))
+#define SPI_SPSR_BITS 0
+#else
+#error "DISPLAY_SPI_MAX_HZ is below F_CPU/128, the slowest SPI clock"
+#endif
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,49 @@
+/*
+ * config.h
+ *
+ * Board configuration shared by every module: clock, pins and screen size.
+ */
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+// CPU clock, every timer, UART and SPI setting follows from it (see clock.h), e.g. -DF_CPU=20000000UL on a 20 MHz board
+#ifndef F_CPU
+#define F_CPU 1000000UL
+#endif
+#define BAUDRATE 9600UL
+
+// Telemetry builds (-DTELEMETRY) send profiling frames on TXD0, which is PD1 = the right button: the transmitter is
+// only switched on while a frame goes out (UartPut enables it, the transmit complete interrupt disables it once the
+// queue is empty) and PD1 is the pulled-up key input the rest of the time. The key is ignored while the transmitter
+// drives the pin and needs a series resistor (1k or more) so a press during a frame can't short the driver
+
+#include <avr/io.h>
+
+#define P_SCK  PINB7
+#define P_COPI PINB5
+#define P_CD   PINB6
+#define P_RST  PINB4
+#define SCREEN_ROW 6        // 48 pixels, 8 pixels each
+#define SCREEN_COLUMN 84    // 84 pixels
+#define P_LED  PIND6
+#define P_SW1  PIND5
+#define SW_VERSION		13
+#define P_UP PIND0
+#define P_RGT PIND1
+#define P_LFT PIND2
+#define P_DWN PIND3
+
+// Pin descriptors (port letter, bit) for the IO_ macros
+#define IO_SCK  B, P_SCK
+#define IO_COPI B, P_COPI
+#define IO_CD   B, P_CD
+#define IO_RST  B, P_RST
+#define IO_LED  D, P_LED
+#define IO_SW1  D, P_SW1
+#define IO_UP   D, P_UP
+#define IO_RGT  D, P_RGT
+#define IO_LFT  D, P_LFT
+#define IO_DWN  D, P_DWN
+
+#endif /* CONFIG_H_ */
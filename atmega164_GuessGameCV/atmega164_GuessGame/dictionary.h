@@ -0,0 +1,140 @@
+/*
+ * Generated by tools/gen_dictionary.py from words.txt, do not edit.
+ *
+ * 313 words, 1315 bytes packed + 56 bytes index (2408 bytes as C strings)
+ */
+
+#ifndef DICTIONARY_H_
+#define DICTIONARY_H_
+
+#define DICT_WORD_COUNT 313
+#define DICT_LENGTH_MIN 3
+#define DICT_LENGTH_MAX 15
+
+// Number of the first word of each length (DICT_LENGTH_MIN first, then a sentinel)
+const PROGMEM unsigned int DICT_BUCKET_FIRST[] = {
+        0,     3,    28,    84,   171,   221,   260,   289,
+      302,   308,   310,   312,   312,   313,
+};
+
+// Byte offset in DICT_DATA where the words of each length start (then a sentinel)
+const PROGMEM unsigned int DICT_BUCKET_OFFSET[] = {
+        0,     6,    69,   244,   571,   790,   985,  1149,
+     1231,  1273,  1288,  1305,  1305,  1315,
+};
+
+// 5 bit letter codes (A = 0), LSB first, one bucket after the other
+const PROGMEM unsigned char DICT_DATA[] = {
+    0x01, 0xcd, 0x40, 0xa5, 0x3b, 0x0c, 0x01, 0xd0, 0x11, 0xf0, 0x24, 0x82,
+    0xac, 0x25, 0x0e, 0x7a, 0x03, 0x4c, 0x30, 0x22, 0x65, 0x64, 0x18, 0x52,
+    0x16, 0x30, 0xc5, 0xb5, 0x59, 0xa8, 0x24, 0x06, 0xa0, 0x66, 0xc0, 0x24,
+    0x26, 0xa2, 0x71, 0x40, 0x7c, 0x09, 0xe4, 0xac, 0x90, 0x45, 0x0b, 0xb9,
+    0xb6, 0x9c, 0x7b, 0x8f, 0x80, 0xf8, 0x16, 0x65, 0xcf, 0xc5, 0x09, 0x29,
+    0xca, 0x16, 0xcc, 0x69, 0x51, 0x24, 0xd6, 0xc5, 0x01, 0xe0, 0xbd, 0x45,
+    0x40, 0x8c, 0x00, 0x07, 0x07, 0xe2, 0x10, 0x20, 0x2c, 0x22, 0x80, 0x38,
+    0x44, 0x80, 0x18, 0xb1, 0x20, 0x6b, 0x39, 0xb1, 0x9c, 0x50, 0xc2, 0x31,
+    0x32, 0x05, 0x16, 0x8b, 0x0c, 0xb2, 0x00, 0x1e, 0xc8, 0x0d, 0x32, 0x22,
+    0x40, 0x8d, 0x00, 0xb3, 0x08, 0x89, 0xd1, 0x45, 0x52, 0x49, 0x9b, 0x05,
+    0x91, 0x35, 0x4a, 0x72, 0x71, 0x94, 0x05, 0xe4, 0x29, 0xcb, 0x81, 0x59,
+    0x16, 0x9d, 0xa4, 0x44, 0xc0, 0x88, 0x59, 0xf8, 0x1d, 0x13, 0xc1, 0x23,
+    0x86, 0x12, 0x29, 0x0f, 0x89, 0x33, 0xa3, 0xf6, 0xe8, 0x4c, 0x8e, 0x2e,
+    0xb2, 0xc0, 0x14, 0x67, 0x11, 0xe6, 0xda, 0x72, 0x06, 0x09, 0x06, 0x9a,
+    0x71, 0x8c, 0x2c, 0xd7, 0x18, 0x99, 0x24, 0x32, 0x37, 0x5d, 0x6c, 0x0e,
+    0x49, 0xe2, 0x04, 0x01, 0xcd, 0xc5, 0x80, 0xe6, 0x23, 0x40, 0x9c, 0x77,
+    0x80, 0x24, 0x0f, 0x81, 0xe6, 0x1e, 0xba, 0x64, 0x3d, 0x67, 0x49, 0x7c,
+    0x74, 0x49, 0x02, 0x29, 0xa1, 0x24, 0x82, 0x81, 0x5c, 0x24, 0x0b, 0xe0,
+    0x48, 0x24, 0x99, 0x11, 0x55, 0x12, 0xe5, 0x41, 0x65, 0xca, 0x09, 0x84,
+    0x92, 0x13, 0x4c, 0x32, 0x91, 0x21, 0x71, 0x22, 0x46, 0xe2, 0x74, 0x96,
+    0xc4, 0x4c, 0x42, 0x04, 0xa0, 0x81, 0xe5, 0x0c, 0xa0, 0x93, 0xb2, 0x16,
+    0x40, 0x03, 0x0d, 0x04, 0xd4, 0x40, 0xc4, 0x01, 0x4d, 0x06, 0x5e, 0x88,
+    0xa0, 0x89, 0x13, 0x22, 0x1a, 0x86, 0x04, 0x5a, 0x0a, 0x89, 0x81, 0xce,
+    0xe9, 0x9a, 0x00, 0x0d, 0xbb, 0x26, 0x80, 0x9c, 0x8b, 0x88, 0x03, 0xa2,
+    0x21, 0xe2, 0x90, 0x18, 0xb1, 0x70, 0xef, 0x91, 0x28, 0x68, 0x94, 0x2e,
+    0x0e, 0x22, 0x49, 0x9c, 0x83, 0x48, 0x64, 0xda, 0x20, 0x15, 0x09, 0x32,
+    0x22, 0x30, 0xae, 0x8d, 0x88, 0x2a, 0x89, 0x84, 0xbc, 0xe8, 0x18, 0x69,
+    0x24, 0x1a, 0x4c, 0x9a, 0x41, 0x8d, 0x14, 0xb0, 0x84, 0x6b, 0x05, 0xad,
+    0x49, 0x62, 0x71, 0x91, 0xc8, 0x69, 0xc0, 0x02, 0x17, 0x1b, 0x10, 0x07,
+    0x69, 0x26, 0x3a, 0xda, 0x86, 0xa1, 0x68, 0x82, 0x78, 0x40, 0x0c, 0x2e,
+    0x1e, 0x02, 0x06, 0x89, 0x48, 0x2e, 0xd0, 0x46, 0xa2, 0xec, 0x91, 0xa8,
+    0x48, 0x6c, 0x64, 0x29, 0x82, 0x1f, 0x18, 0xaa, 0x21, 0x73, 0xe6, 0x02,
+    0xd8, 0xd1, 0xb9, 0x50, 0x53, 0x24, 0x32, 0x60, 0x1a, 0x99, 0x0c, 0x44,
+    0x45, 0x26, 0x03, 0x33, 0xa2, 0xcb, 0x08, 0x18, 0xce, 0x32, 0xc2, 0x5c,
+    0xc4, 0xcc, 0x0d, 0xba, 0x08, 0xa3, 0x92, 0x50, 0xd6, 0x48, 0xa0, 0x0b,
+    0x34, 0x14, 0xc2, 0x22, 0x8d, 0xb2, 0x40, 0xa2, 0x2b, 0x45, 0x92, 0xe9,
+    0x9e, 0x70, 0x83, 0xb8, 0x08, 0x9a, 0x21, 0x8e, 0xce, 0x47, 0xa7, 0xbb,
+    0xd8, 0x90, 0xf6, 0x80, 0x50, 0x64, 0x3e, 0x10, 0xd1, 0xc4, 0x6f, 0x81,
+    0x46, 0xe6, 0xa3, 0x39, 0x2f, 0x02, 0x29, 0x88, 0x33, 0x47, 0x10, 0x02,
+    0x9a, 0xf1, 0xe0, 0x79, 0x58, 0x44, 0x63, 0x2c, 0x12, 0x9d, 0x50, 0x64,
+    0x46, 0x47, 0x27, 0x89, 0x12, 0xb0, 0xb7, 0x88, 0x14, 0xc7, 0xb9, 0x25,
+    0x45, 0x24, 0xa4, 0x49, 0xd2, 0xa4, 0x8b, 0x92, 0x44, 0x04, 0x96, 0x44,
+    0xa6, 0x81, 0x25, 0x9d, 0x50, 0x64, 0x4a, 0xb7, 0x06, 0x89, 0xf2, 0x1d,
+    0xd4, 0xae, 0x7c, 0x11, 0x35, 0x23, 0x29, 0x63, 0x24, 0x4a, 0x8b, 0xa6,
+    0x38, 0x12, 0xcb, 0x49, 0xd8, 0x24, 0x72, 0x92, 0x38, 0x9d, 0x31, 0x8b,
+    0x4c, 0x1a, 0xe7, 0x22, 0xf4, 0x2d, 0x07, 0x46, 0x05, 0x6b, 0x11, 0x5c,
+    0x89, 0x98, 0x2e, 0x56, 0xe4, 0x16, 0x6a, 0x16, 0xb5, 0x49, 0xa2, 0x45,
+    0x19, 0xc4, 0x91, 0x91, 0xc9, 0xc0, 0x00, 0x60, 0x8c, 0x48, 0xa4, 0x04,
+    0x6d, 0x92, 0xd6, 0x40, 0x00, 0x73, 0x92, 0x88, 0x83, 0x73, 0x8b, 0x80,
+    0x26, 0xc0, 0x3c, 0x6e, 0x10, 0x71, 0x40, 0x6b, 0x64, 0x09, 0x14, 0x05,
+    0x45, 0x53, 0xb8, 0x26, 0xdd, 0x22, 0xc2, 0xd1, 0x36, 0x49, 0x14, 0x11,
+    0xcb, 0x09, 0x96, 0xa0, 0x31, 0x92, 0x36, 0x07, 0x11, 0x88, 0x81, 0x35,
+    0x88, 0x70, 0x83, 0xc4, 0x81, 0x0c, 0x9a, 0x60, 0x0d, 0x24, 0xdf, 0x02,
+    0x78, 0xa0, 0x8a, 0x06, 0x89, 0xc3, 0xad, 0x77, 0x50, 0x23, 0x8b, 0x30,
+    0xd2, 0x26, 0x61, 0x68, 0x4e, 0x12, 0x49, 0x13, 0x6e, 0x90, 0x48, 0xa6,
+    0x38, 0xa8, 0x19, 0x83, 0x22, 0x28, 0x85, 0x98, 0x05, 0x04, 0x22, 0xf1,
+    0x80, 0x36, 0x16, 0x89, 0xa8, 0x4d, 0x62, 0x48, 0x4c, 0x8e, 0xc6, 0x46,
+    0x70, 0xa2, 0x8a, 0x04, 0x77, 0x15, 0x6a, 0x66, 0x38, 0xb6, 0xc0, 0x24,
+    0x4d, 0xe0, 0x85, 0x42, 0x04, 0x11, 0x33, 0x20, 0x0e, 0x6a, 0x84, 0x11,
+    0x29, 0x81, 0x21, 0xcc, 0x35, 0x34, 0x5d, 0x64, 0x58, 0x4e, 0x12, 0x71,
+    0x23, 0xd3, 0xba, 0xa8, 0xdc, 0x23, 0x11, 0xb4, 0xf1, 0x48, 0x33, 0x14,
+    0xb5, 0xe7, 0x50, 0x9b, 0x24, 0xbe, 0xe8, 0x4c, 0x04, 0x2c, 0x02, 0xd4,
+    0x82, 0xb3, 0x12, 0x2d, 0x24, 0x5c, 0x93, 0x8f, 0x00, 0x45, 0xa2, 0x9c,
+    0x60, 0x20, 0xca, 0xe6, 0x21, 0x60, 0x92, 0x38, 0x0f, 0x6d, 0x83, 0xc4,
+    0xe9, 0x62, 0x03, 0xc3, 0xcd, 0x88, 0x8c, 0x21, 0x71, 0x46, 0xca, 0x1e,
+    0x99, 0xd5, 0x2d, 0x01, 0x9a, 0xab, 0x6e, 0x4d, 0x60, 0x08, 0x40, 0x4a,
+    0xc2, 0xc2, 0xc2, 0x40, 0x4e, 0x12, 0x1d, 0x1a, 0x61, 0xa1, 0x9c, 0x41,
+    0x1c, 0x21, 0x3a, 0xdb, 0x1c, 0x9d, 0xe2, 0x10, 0xa1, 0x24, 0x65, 0xc2,
+    0xb1, 0x87, 0x16, 0x89, 0xc2, 0xb1, 0x47, 0x27, 0x89, 0xc2, 0x35, 0x39,
+    0x41, 0x9b, 0xc2, 0xb5, 0x19, 0x81, 0x9c, 0x83, 0x04, 0x6a, 0x0c, 0x89,
+    0x64, 0x11, 0x31, 0xa3, 0x6b, 0x64, 0x91, 0x77, 0x40, 0x9b, 0x84, 0xd1,
+    0x05, 0xa6, 0x8b, 0xe4, 0x3e, 0xd7, 0x48, 0x9b, 0x85, 0x90, 0x11, 0x80,
+    0x50, 0x05, 0x45, 0x66, 0x41, 0x24, 0x85, 0x36, 0x31, 0x91, 0x6b, 0x26,
+    0x82, 0x77, 0x90, 0x90, 0x07, 0xc4, 0x61, 0x41, 0x24, 0x87, 0x80, 0x29,
+    0x51, 0x53, 0xa8, 0x0d, 0x2a, 0xa6, 0x8b, 0xa8, 0x55, 0x12, 0x27, 0x89,
+    0x0a, 0x34, 0x03, 0xa2, 0x73, 0x8a, 0xe0, 0xe0, 0x40, 0x1c, 0xcc, 0xd1,
+    0x36, 0x01, 0x6a, 0xee, 0x91, 0x08, 0xa6, 0x8b, 0xae, 0x92, 0x58, 0x96,
+    0xb3, 0xcf, 0x2d, 0x10, 0xd1, 0xc4, 0x2f, 0xba, 0xe9, 0x84, 0x5b, 0x91,
+    0x08, 0x82, 0x2a, 0x89, 0x91, 0x18, 0x24, 0x27, 0x89, 0x91, 0x48, 0x24,
+    0xa7, 0x8b, 0xd2, 0x95, 0x69, 0x41, 0x24, 0x93, 0x44, 0x86, 0x1a, 0x58,
+    0x33, 0x12, 0x20, 0x69, 0x24, 0xb4, 0x49, 0x64, 0x1a, 0x19, 0x15, 0x44,
+    0x04, 0xc2, 0x22, 0x16, 0x4c, 0x71, 0x86, 0x33, 0x16, 0x54, 0x52, 0x5c,
+    0x64, 0x60, 0x19, 0x17, 0xd1, 0x3c, 0x0c, 0x2c, 0x64, 0x1a, 0x23, 0x6d,
+    0x02, 0xf6, 0x16, 0x2a, 0x88, 0x44, 0x20, 0x25, 0x61, 0x61, 0x91, 0x18,
+    0x80, 0x50, 0x0b, 0x99, 0x33, 0x03, 0x68, 0xc3, 0xa2, 0x31, 0x8f, 0x00,
+    0x0f, 0x08, 0x34, 0x5d, 0x14, 0x07, 0x44, 0x20, 0x26, 0x89, 0xc2, 0xb5,
+    0x41, 0xc5, 0x74, 0x51, 0xb8, 0xd6, 0x88, 0x98, 0x2e, 0x0a, 0xd7, 0x2a,
+    0x89, 0x93, 0xc4, 0x12, 0x09, 0xa4, 0xa4, 0x09, 0x6c, 0x48, 0x23, 0x11,
+    0x4c, 0x17, 0x11, 0x7b, 0x64, 0x80, 0x26, 0x08, 0x6a, 0x92, 0x2e, 0x30,
+    0x5d, 0x44, 0x6d, 0x92, 0x58, 0x80, 0x20, 0xa8, 0x4d, 0x12, 0x23, 0x7d,
+    0x93, 0x21, 0x11, 0x9d, 0x38, 0xe8, 0xb9, 0x37, 0x11, 0x43, 0x99, 0xc4,
+    0x17, 0x89, 0x14, 0x60, 0x91, 0xf8, 0xa2, 0x13, 0x44, 0x4a, 0x17, 0x23,
+    0x11, 0x13, 0x15, 0x44, 0x62, 0x24, 0x86, 0x2e, 0x30, 0x5d, 0x8c, 0x44,
+    0xba, 0x06, 0xa6, 0x8b, 0x12, 0x4c, 0xb2, 0x16, 0x9a, 0x44, 0x8a, 0x43,
+    0x06, 0x5d, 0x24, 0x4a, 0xc4, 0xe8, 0x02, 0xd3, 0xc5, 0x49, 0x16, 0x91,
+    0xc2, 0x3d, 0x52, 0xdd, 0x9a, 0x8c, 0x4c, 0x12, 0x01, 0x60, 0x4e, 0xd2,
+    0x28, 0x98, 0x2e, 0x06, 0xe7, 0xe6, 0x72, 0x60, 0x90, 0x18, 0x22, 0x01,
+    0x23, 0x38, 0x10, 0x47, 0x88, 0x04, 0xa8, 0xe7, 0x50, 0x9b, 0x02, 0x2c,
+    0x41, 0x17, 0x98, 0x2e, 0x0a, 0xc7, 0x1e, 0x88, 0x60, 0xba, 0x28, 0x5c,
+    0x9b, 0xd1, 0xad, 0x45, 0x22, 0xa3, 0x6b, 0x22, 0x46, 0x26, 0x89, 0x4e,
+    0x0a, 0xb4, 0x16, 0x98, 0x2e, 0x3e, 0x12, 0xd1, 0x3b, 0x24, 0x82, 0x25,
+    0x69, 0x88, 0x8e, 0x4e, 0xd4, 0xc8, 0x3c, 0x24, 0x32, 0x24, 0xa7, 0x8b,
+    0x33, 0x82, 0x26, 0x91, 0x9c, 0x2e, 0x02, 0xe0, 0xbd, 0x85, 0x04, 0x98,
+    0xc8, 0xb5, 0x43, 0x2e, 0x18, 0x44, 0x20, 0x06, 0x16, 0x6a, 0x72, 0x46,
+    0x2a, 0x26, 0x72, 0x8d, 0xd1, 0x35, 0xd1, 0x5b, 0xe4, 0x92, 0x38, 0x23,
+    0x68, 0xb2, 0xb8, 0xc8, 0x48, 0x9c, 0x11, 0x34, 0xc9, 0xd0, 0x9c, 0x24,
+    0x02, 0x20, 0x8a, 0x83, 0x26, 0x11, 0x93, 0x46, 0xe2, 0xa4, 0x40, 0x6b,
+    0x39, 0x29, 0xdc, 0x23, 0xcf, 0x4d, 0xd2, 0x26, 0x72, 0x8c, 0x4c, 0x12,
+    0x25, 0x61, 0x48, 0xb8, 0x36, 0xa8, 0x98, 0x2e, 0x02, 0x0c, 0x89, 0xe8,
+    0x84, 0x6b, 0x33, 0xba, 0xb5, 0x48, 0x04,
+};
+
+#endif /* DICTIONARY_H_ */
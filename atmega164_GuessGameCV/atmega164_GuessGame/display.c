@@ -0,0 +1,978 @@
+/*
+ * display.c
+ *
+ * PCD8544 driver: drawing goes into a RAM framebuffer and DisplayFlush() sends only what changed.
+ */
+
+#include "config.h"      // F_CPU before util/delay.h
+
+#include <stdbool.h>
+#include <string.h>
+#include <util/delay.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+#include "bench.h"
+#include "display.h"
+#include "spi.h"
+#include "telemetry.h"
+
+const PROGMEM unsigned char FONT[] = {
+    0x00, 0x00, 0x00,   // 0x20  
+    0x00, 0x2e, 0x00,   // 0x21 !
+    0x06, 0x00, 0x06,   // 0x22 "
+    0x3e, 0x14, 0x3e,   // 0x23 #
+    0x2c, 0x7e, 0x34,   // 0x24 $
+    0x12, 0x08, 0x24,   // 0x25 %
+    0x14, 0x2a, 0x34,   // 0x26 &
+    0x00, 0x06, 0x00,   // 0x27 '
+    0x1c, 0x22, 0x00,   // 0x28 (
+    0x00, 0x22, 0x1c,   // 0x29 )
+    0x0a, 0x04, 0x0a,   // 0x2a *
+    0x08, 0x1c, 0x08,   // 0x2b +
+    0x40, 0x30, 0x00,   // 0x2c ,
+    0x08, 0x08, 0x08,   // 0x2d -
+    0x00, 0x60, 0x60,   // 0x2e .
+    0x10, 0x08, 0x04,   // 0x2f /
+    0x1c, 0x2a, 0x1c,   // 0x30 0
+    0x04, 0x3e, 0x00,   // 0x31 1
+    0x32, 0x2a, 0x24,   // 0x32 2
+    0x2a, 0x2a, 0x14,   // 0x33 3
+    0x18, 0x14, 0x3a,   // 0x34 4
+    0x2e, 0x2a, 0x3a,   // 0x35 5
+    0x3e, 0x2a, 0x3a,   // 0x36 6
+    0x02, 0x3a, 0x06,   // 0x37 7
+    0x3e, 0x2a, 0x3e,   // 0x38 8
+    0x2e, 0x2a, 0x3e,   // 0x39 9
+    0x00, 0x14, 0x00,   // 0x3a :
+    0x20, 0x14, 0x00,   // 0x3b ;
+    0x08, 0x1c, 0x14,   // 0x3c <
+    0x14, 0x14, 0x14,   // 0x3d =
+    0x14, 0x1c, 0x08,   // 0x3e >
+    0x02, 0x2a, 0x04,   // 0x3f ?
+    0x00, 0x00, 0x00,   // 0x40 @
+    0x3c, 0x0a, 0x3c,   // 0x41 A
+    0x3e, 0x2a, 0x14,   // 0x42 B
+    0x1c, 0x22, 0x22,   // 0x43 C
+    0x3e, 0x22, 0x1c,   // 0x44 D
+    0x3e, 0x2a, 0x2a,   // 0x45 E
+    0x3e, 0x0a, 0x0a,   // 0x46 F
+    0x1c, 0x22, 0x3a,   // 0x47 G
+    0x3e, 0x08, 0x3e,   // 0x48 H
+    0x22, 0x3e, 0x22,   // 0x49 I
+    0x10, 0x20, 0x1e,   // 0x4a J
+    0x3e, 0x08, 0x36,   // 0x4b K
+    0x3e, 0x20, 0x20,   // 0x4c L
+    0x3e, 0x0c, 0x3e,   // 0x4d M
+    0x3e, 0x1c, 0x3e,   // 0x4e N
+    0x1c, 0x22, 0x1c,   // 0x4f O
+    0x3e, 0x0a, 0x04,   // 0x50 P
+    0x1c, 0x32, 0x3c,   // 0x51 Q
+    0x3e, 0x0a, 0x34,   // 0x52 R
+    0x24, 0x2a, 0x12,   // 0x53 S
+    0x02, 0x3e, 0x02,   // 0x54 T
+    0x3e, 0x20, 0x3e,   // 0x55 U
+    0x0e, 0x30, 0x0e,   // 0x56 V
+    0x3e, 0x18, 0x3e,   // 0x57 W
+    0x36, 0x08, 0x36,   // 0x58 X
+    0x06, 0x38, 0x06,   // 0x59 Y
+    0x32, 0x2a, 0x26,   // 0x5a Z
+    0x3e, 0x22, 0x00,   // 0x5b [
+    0x04, 0x08, 0x10,   // 0x5c \/
+    0x00, 0x22, 0x3e,   // 0x5d ]
+    0x06, 0x03, 0x06,   // 0x5e ^
+    0x20, 0x20, 0x20,   // 0x5f _
+    0x02, 0x04, 0x00,   // 0x60 `
+    0x10, 0x28, 0x38,   // 0x61 a
+    0x3e, 0x28, 0x10,   // 0x62 b
+    0x30, 0x28, 0x28,   // 0x63 c
+    0x10, 0x28, 0x3e,   // 0x64 d
+    0x18, 0x2c, 0x2c,   // 0x65 e
+    0x08, 0x3c, 0x0a,   // 0x66 f
+    0x90, 0xa8, 0x78,   // 0x67 g
+    0x3e, 0x08, 0x30,   // 0x68 h
+    0x00, 0x3a, 0x00,   // 0x69 i
+    0x40, 0x3a, 0x00,   // 0x6a j
+    0x3e, 0x10, 0x28,   // 0x6b k
+    0x00, 0x3e, 0x00,   // 0x6c l
+    0x38, 0x18, 0x38,   // 0x6d m
+    0x38, 0x08, 0x30,   // 0x6e n
+    0x38, 0x28, 0x38,   // 0x6f o
+    0xf8, 0x28, 0x10,   // 0x70 p
+    0x10, 0x28, 0xf8,   // 0x71 q
+    0x38, 0x08, 0x08,   // 0x72 r
+    0x20, 0x38, 0x08,   // 0x73 s
+    0x04, 0x3e, 0x24,   // 0x74 t
+    0x38, 0x20, 0x38,   // 0x75 u
+    0x18, 0x30, 0x18,   // 0x76 v
+    0x38, 0x30, 0x38,   // 0x77 w
+    0x28, 0x10, 0x28,   // 0x78 x
+    0x98, 0x60, 0x18,   // 0x79 y
+    0x08, 0x38, 0x20,   // 0x7a z
+    0x08, 0x1c, 0x22,   // 0x7b {
+    0x00, 0x7e, 0x00,   // 0x7c |
+    0x22, 0x1c, 0x08,   // 0x7d }
+    0x08, 0x18, 0x10,   // 0x7e ~
+};
+
+// Scaled text: every bit of a glyph column becomes 2 (or 3) bits, so one table lookup gives a whole output byte
+// 2x: the low nibble of a column makes the upper bank, the high nibble the lower one
+const PROGMEM unsigned char FONT_X2[16] = {
+    0x00, 0x03, 0x0c, 0x0f, 0x30, 0x33, 0x3c, 0x3f, 0xc0, 0xc3, 0xcc, 0xcf, 0xf0, 0xf3, 0xfc, 0xff,
+};
+// 3x: the 24 output bits split into bits 0-2 (column & 7), 2-5 ((column >> 2) & 15) and 5-7 (column >> 5)
+const PROGMEM unsigned char FONT_X3_TOP[8] = {
+    0x00, 0x07, 0x38, 0x3f, 0xc0, 0xc7, 0xf8, 0xff,
+};
+const PROGMEM unsigned char FONT_X3_MIDDLE[16] = {
+    0x00, 0x01, 0x0e, 0x0f, 0x70, 0x71, 0x7e, 0x7f, 0x80, 0x81, 0x8e, 0x8f, 0xf0, 0xf1, 0xfe, 0xff,
+};
+const PROGMEM unsigned char FONT_X3_BOTTOM[8] = {
+    0x00, 0x03, 0x1c, 0x1f, 0xe0, 0xe3, 0xfc, 0xff,
+};
+
+// Proportional font: the columns of every glyph without its blank columns, packed one glyph after the other
+// FONT_GLYPHS holds where each glyph starts and how wide it is, the blank column after a glyph is not stored
+const PROGMEM unsigned char FONT_PROP[] = {
+    0x00, 0x00,         // 0x20
+    0x2e,               // 0x21 !
+    0x06, 0x00, 0x06,   // 0x22 "
+    0x3e, 0x14, 0x3e,   // 0x23 #
+    0x2c, 0x7e, 0x34,   // 0x24 $
+    0x12, 0x08, 0x24,   // 0x25 %
+    0x14, 0x2a, 0x34,   // 0x26 &
+    0x06,               // 0x27 '
+    0x1c, 0x22,         // 0x28 (
+    0x22, 0x1c,         // 0x29 )
+    0x0a, 0x04, 0x0a,   // 0x2a *
+    0x08, 0x1c, 0x08,   // 0x2b +
+    0x40, 0x30,         // 0x2c ,
+    0x08, 0x08, 0x08,   // 0x2d -
+    0x60, 0x60,         // 0x2e .
+    0x10, 0x08, 0x04,   // 0x2f /
+    0x1c, 0x2a, 0x1c,   // 0x30 0
+    0x04, 0x3e,         // 0x31 1
+    0x32, 0x2a, 0x24,   // 0x32 2
+    0x2a, 0x2a, 0x14,   // 0x33 3
+    0x18, 0x14, 0x3a,   // 0x34 4
+    0x2e, 0x2a, 0x3a,   // 0x35 5
+    0x3e, 0x2a, 0x3a,   // 0x36 6
+    0x02, 0x3a, 0x06,   // 0x37 7
+    0x3e, 0x2a, 0x3e,   // 0x38 8
+    0x2e, 0x2a, 0x3e,   // 0x39 9
+    0x14,               // 0x3a :
+    0x20, 0x14,         // 0x3b ;
+    0x08, 0x1c, 0x14,   // 0x3c <
+    0x14, 0x14, 0x14,   // 0x3d =
+    0x14, 0x1c, 0x08,   // 0x3e >
+    0x02, 0x2a, 0x04,   // 0x3f ?
+    // 0x40 @ has no glyph, it is printed as *
+    0x3c, 0x0a, 0x3c,   // 0x41 A
+    0x3e, 0x2a, 0x14,   // 0x42 B
+    0x1c, 0x22, 0x22,   // 0x43 C
+    0x3e, 0x22, 0x1c,   // 0x44 D
+    0x3e, 0x2a, 0x2a,   // 0x45 E
+    0x3e, 0x0a, 0x0a,   // 0x46 F
+    0x1c, 0x22, 0x3a,   // 0x47 G
+    0x3e, 0x08, 0x3e,   // 0x48 H
+    0x22, 0x3e, 0x22,   // 0x49 I
+    0x10, 0x20, 0x1e,   // 0x4a J
+    0x3e, 0x08, 0x36,   // 0x4b K
+    0x3e, 0x20, 0x20,   // 0x4c L
+    0x3e, 0x0c, 0x3e,   // 0x4d M
+    0x3e, 0x1c, 0x3e,   // 0x4e N
+    0x1c, 0x22, 0x1c,   // 0x4f O
+    0x3e, 0x0a, 0x04,   // 0x50 P
+    0x1c, 0x32, 0x3c,   // 0x51 Q
+    0x3e, 0x0a, 0x34,   // 0x52 R
+    0x24, 0x2a, 0x12,   // 0x53 S
+    0x02, 0x3e, 0x02,   // 0x54 T
+    0x3e, 0x20, 0x3e,   // 0x55 U
+    0x0e, 0x30, 0x0e,   // 0x56 V
+    0x3e, 0x18, 0x3e,   // 0x57 W
+    0x36, 0x08, 0x36,   // 0x58 X
+    0x06, 0x38, 0x06,   // 0x59 Y
+    0x32, 0x2a, 0x26,   // 0x5a Z
+    0x3e, 0x22,         // 0x5b [
+    0x04, 0x08, 0x10,   // 0x5c \/
+    0x22, 0x3e,         // 0x5d ]
+    0x06, 0x03, 0x06,   // 0x5e ^
+    0x20, 0x20, 0x20,   // 0x5f _
+    0x02, 0x04,         // 0x60 `
+    0x10, 0x28, 0x38,   // 0x61 a
+    0x3e, 0x28, 0x10,   // 0x62 b
+    0x30, 0x28, 0x28,   // 0x63 c
+    0x10, 0x28, 0x3e,   // 0x64 d
+    0x18, 0x2c, 0x2c,   // 0x65 e
+    0x08, 0x3c, 0x0a,   // 0x66 f
+    0x90, 0xa8, 0x78,   // 0x67 g
+    0x3e, 0x08, 0x30,   // 0x68 h
+    0x3a,               // 0x69 i
+    0x40, 0x3a,         // 0x6a j
+    0x3e, 0x10, 0x28,   // 0x6b k
+    0x3e,               // 0x6c l
+    0x38, 0x18, 0x38,   // 0x6d m
+    0x38, 0x08, 0x30,   // 0x6e n
+    0x38, 0x28, 0x38,   // 0x6f o
+    0xf8, 0x28, 0x10,   // 0x70 p
+    0x10, 0x28, 0xf8,   // 0x71 q
+    0x38, 0x08, 0x08,   // 0x72 r
+    0x20, 0x38, 0x08,   // 0x73 s
+    0x04, 0x3e, 0x24,   // 0x74 t
+    0x38, 0x20, 0x38,   // 0x75 u
+    0x18, 0x30, 0x18,   // 0x76 v
+    0x38, 0x30, 0x38,   // 0x77 w
+    0x28, 0x10, 0x28,   // 0x78 x
+    0x98, 0x60, 0x18,   // 0x79 y
+    0x08, 0x38, 0x20,   // 0x7a z
+    0x08, 0x1c, 0x22,   // 0x7b {
+    0x7e,               // 0x7c |
+    0x22, 0x1c, 0x08,   // 0x7d }
+    0x08, 0x18, 0x10,   // 0x7e ~
+};
+
+#define GLYPH(offset, width) ((offset) | ((unsigned int)(width) << 14))
+#define GLYPH_OFFSET(glyph) ((glyph) & 0x3FFF)
+#define GLYPH_WIDTH(glyph) ((glyph) >> 14)
+const PROGMEM unsigned int FONT_GLYPHS[] = {
+    GLYPH(  0, 2),     // 0x20
+    GLYPH(  2, 1),     // 0x21 !
+    GLYPH(  3, 3),     // 0x22 "
+    GLYPH(  6, 3),     // 0x23 #
+    GLYPH(  9, 3),     // 0x24 $
+    GLYPH( 12, 3),     // 0x25 %
+    GLYPH( 15, 3),     // 0x26 &
+    GLYPH( 18, 1),     // 0x27 '
+    GLYPH( 19, 2),     // 0x28 (
+    GLYPH( 21, 2),     // 0x29 )
+    GLYPH( 23, 3),     // 0x2a *
+    GLYPH( 26, 3),     // 0x2b +
+    GLYPH( 29, 2),     // 0x2c ,
+    GLYPH( 31, 3),     // 0x2d -
+    GLYPH( 34, 2),     // 0x2e .
+    GLYPH( 36, 3),     // 0x2f /
+    GLYPH( 39, 3),     // 0x30 0
+    GLYPH( 42, 2),     // 0x31 1
+    GLYPH( 44, 3),     // 0x32 2
+    GLYPH( 47, 3),     // 0x33 3
+    GLYPH( 50, 3),     // 0x34 4
+    GLYPH( 53, 3),     // 0x35 5
+    GLYPH( 56, 3),     // 0x36 6
+    GLYPH( 59, 3),     // 0x37 7
+    GLYPH( 62, 3),     // 0x38 8
+    GLYPH( 65, 3),     // 0x39 9
+    GLYPH( 68, 1),     // 0x3a :
+    GLYPH( 69, 2),     // 0x3b ;
+    GLYPH( 71, 3),     // 0x3c <
+    GLYPH( 74, 3),     // 0x3d =
+    GLYPH( 77, 3),     // 0x3e >
+    GLYPH( 80, 3),     // 0x3f ?
+    GLYPH( 83, 0),     // 0x40 @
+    GLYPH( 83, 3),     // 0x41 A
+    GLYPH( 86, 3),     // 0x42 B
+    GLYPH( 89, 3),     // 0x43 C
+    GLYPH( 92, 3),     // 0x44 D
+    GLYPH( 95, 3),     // 0x45 E
+    GLYPH( 98, 3),     // 0x46 F
+    GLYPH(101, 3),     // 0x47 G
+    GLYPH(104, 3),     // 0x48 H
+    GLYPH(107, 3),     // 0x49 I
+    GLYPH(110, 3),     // 0x4a J
+    GLYPH(113, 3),     // 0x4b K
+    GLYPH(116, 3),     // 0x4c L
+    GLYPH(119, 3),     // 0x4d M
+    GLYPH(122, 3),     // 0x4e N
+    GLYPH(125, 3),     // 0x4f O
+    GLYPH(128, 3),     // 0x50 P
+    GLYPH(131, 3),     // 0x51 Q
+    GLYPH(134, 3),     // 0x52 R
+    GLYPH(137, 3),     // 0x53 S
+    GLYPH(140, 3),     // 0x54 T
+    GLYPH(143, 3),     // 0x55 U
+    GLYPH(146, 3),     // 0x56 V
+    GLYPH(149, 3),     // 0x57 W
+    GLYPH(152, 3),     // 0x58 X
+    GLYPH(155, 3),     // 0x59 Y
+    GLYPH(158, 3),     // 0x5a Z
+    GLYPH(161, 2),     // 0x5b [
+    GLYPH(163, 3),     // 0x5c \/
+    GLYPH(166, 2),     // 0x5d ]
+    GLYPH(168, 3),     // 0x5e ^
+    GLYPH(171, 3),     // 0x5f _
+    GLYPH(174, 2),     // 0x60 `
+    GLYPH(176, 3),     // 0x61 a
+    GLYPH(179, 3),     // 0x62 b
+    GLYPH(182, 3),     // 0x63 c
+    GLYPH(185, 3),     // 0x64 d
+    GLYPH(188, 3),     // 0x65 e
+    GLYPH(191, 3),     // 0x66 f
+    GLYPH(194, 3),     // 0x67 g
+    GLYPH(197, 3),     // 0x68 h
+    GLYPH(200, 1),     // 0x69 i
+    GLYPH(201, 2),     // 0x6a j
+    GLYPH(203, 3),     // 0x6b k
+    GLYPH(206, 1),     // 0x6c l
+    GLYPH(207, 3),     // 0x6d m
+    GLYPH(210, 3),     // 0x6e n
+    GLYPH(213, 3),     // 0x6f o
+    GLYPH(216, 3),     // 0x70 p
+    GLYPH(219, 3),     // 0x71 q
+    GLYPH(222, 3),     // 0x72 r
+    GLYPH(225, 3),     // 0x73 s
+    GLYPH(228, 3),     // 0x74 t
+    GLYPH(231, 3),     // 0x75 u
+    GLYPH(234, 3),     // 0x76 v
+    GLYPH(237, 3),     // 0x77 w
+    GLYPH(240, 3),     // 0x78 x
+    GLYPH(243, 3),     // 0x79 y
+    GLYPH(246, 3),     // 0x7a z
+    GLYPH(249, 3),     // 0x7b {
+    GLYPH(252, 1),     // 0x7c |
+    GLYPH(253, 3),     // 0x7d }
+    GLYPH(256, 3),     // 0x7e ~
+};
+
+// Controller address pointer as tracked by the driver (0xFF = unknown, e.g. right after reset)
+unsigned char displayX = 0xFF;
+unsigned char displayY = 0xFF;
+
+// Send a command to display over SPI
+void DisplayCMD(unsigned char cmd)
+{
+    spiWait();
+    IO_LOW(IO_CD);          // CD LOW for command
+    spiWrite(cmd);
+}
+
+// Framebuffer holding the whole screen, bank (8 pixel row) after bank, drawing always goes to frameBuffer
+unsigned char frameBuffers[DISPLAY_DOUBLE_BUFFER + 1][SCREEN_ROW * SCREEN_COLUMN];
+unsigned char* frameBuffer = frameBuffers[0];
+// Changed column range of every bank since the last flush (start == end means clean)
+unsigned char dirtyStart[SCREEN_ROW];
+unsigned char dirtyEnd[SCREEN_ROW];
+// Clearing a bank is lazy: its bit in clearPending is set and its columns count as blank for drawing, but the
+// framebuffer keeps what the display shows until the flush. Columns drawn meanwhile get their bit in clearWritten
+// (bit row * SCREEN_COLUMN + col) and only change, and become dirty, where the new pixels differ from the old ones,
+// the flush then blanks the columns nothing was drawn into. A page redrawn from a clear screen only sends what changed
+unsigned char clearPending = 0;
+unsigned char clearWritten[(SCREEN_ROW * SCREEN_COLUMN + 7) / 8];
+
+// Set or reset the clearWritten bits of columns start..end-1 of a bank
+void DisplayMarkWritten(unsigned char row, unsigned char start, unsigned char end, bool written)
+{
+    unsigned int bit = row * SCREEN_COLUMN + start;
+    unsigned int last = row * SCREEN_COLUMN + end;
+    unsigned char mask;
+    while (bit < last)
+    {
+        if (((bit & 7) == 0) && (bit + 8 <= last))
+        {
+            clearWritten[bit >> 3] = written ? 0xFF : 0x00;   // Whole byte at once
+            bit += 8;
+        }
+        else
+        {
+            mask = 1 << (bit & 7);
+            if (written)
+            {
+                clearWritten[bit >> 3] |= mask;
+            }
+            else
+            {
+                clearWritten[bit >> 3] &= ~mask;
+            }
+            bit++;
+        }
+    }
+}
+
+// A bank is waiting for its lazy clear
+bool DisplayPending(unsigned char row)
+{
+    return (clearPending & (1 << row)) != 0;
+}
+
+// Value a column is drawn on: 0 for a column of a bank waiting for its clear that nothing was drawn into yet,
+// otherwise the framebuffer byte. Drawing that combines with the old pixels calls this first, it claims the
+// column, and compares its result with the framebuffer byte to find out whether the column changed
+unsigned char DisplayBase(unsigned char row, unsigned char col)
+{
+    unsigned int bit;
+    if (clearPending & (1 << row))
+    {
+        bit = row * SCREEN_COLUMN + col;
+        if (!(clearWritten[bit >> 3] & (1 << (bit & 7))))
+        {
+            clearWritten[bit >> 3] |= 1 << (bit & 7);
+            return 0x00;
+        }
+    }
+    return frameBuffer[row * SCREEN_COLUMN + col];
+}
+
+// Finish the lazy clear of a bank: the columns nothing was drawn into are blanked, the lit ones become dirty
+void DisplayResolve(unsigned char row)
+{
+    unsigned char col;
+    unsigned int bit = row * SCREEN_COLUMN;
+    unsigned char* pixels = &frameBuffer[row * SCREEN_COLUMN];
+
+    if (!(clearPending & (1 << row)))
+    {
+        return;
+    }
+    clearPending &= ~(1 << row);
+    for (col = 0; col < SCREEN_COLUMN; col++, bit++, pixels++)
+    {
+        if ((*pixels != 0x00) && !(clearWritten[bit >> 3] & (1 << (bit & 7))))
+        {
+            *pixels = 0x00;
+            DisplayMarkDirty(row, col, col + 1);
+        }
+    }
+}
+
+// Add a column range of a bank to the region sent by the next flush
+void DisplayMarkDirty(unsigned char row, unsigned char start, unsigned char end)
+{
+    if (dirtyStart[row] == dirtyEnd[row])
+    {
+        dirtyStart[row] = start;
+        dirtyEnd[row] = end;
+    }
+    else
+    {
+        if (start < dirtyStart[row])
+        {
+            dirtyStart[row] = start;
+        }
+        if (end > dirtyEnd[row])
+        {
+            dirtyEnd[row] = end;
+        }
+    }
+}
+
+// Mark the whole screen as changed (the controller RAM is unknown after reset)
+void DisplayInvalidate()
+{
+    unsigned char row;
+    for (row = 0; row < SCREEN_ROW; row++)
+    {
+        dirtyStart[row] = 0;
+        dirtyEnd[row] = SCREEN_COLUMN;
+    }
+}
+
+// Write one byte of a bank into the framebuffer, only a different value makes it dirty
+void DisplayWrite(unsigned char row, unsigned char col, unsigned char data)
+{
+    unsigned char* pixels = &frameBuffer[row * SCREEN_COLUMN + col];
+    if (clearPending & (1 << row))
+    {
+        DisplayBase(row, col);      // Overwritten, so the clear leaves the column alone
+    }
+    if (*pixels != data)
+    {
+        *pixels = data;
+        DisplayMarkDirty(row, col, col + 1);
+    }
+}
+
+// Flip the pixels of a column range in a bank, doing it twice restores the range
+void DisplayInvert(unsigned char row, unsigned char start, unsigned char end)
+{
+    unsigned char* pixels = &frameBuffer[row * SCREEN_COLUMN + start];
+    unsigned char col;
+    if (end > SCREEN_COLUMN)
+    {
+        end = SCREEN_COLUMN;
+    }
+    if (start < end)
+    {
+        if (clearPending & (1 << row))
+        {
+            for (col = start; col < end; col++)
+            {
+                DisplayWrite(row, col, DisplayBase(row, col) ^ 0xFF);
+            }
+            return;
+        }
+        for (col = start; col < end; col++, pixels++)
+        {
+            *pixels ^= 0xFF;
+        }
+        DisplayMarkDirty(row, start, end);
+    }
+}
+
+// Clear one bank (lazily, see clearPending): what is drawn into it before the next flush only sends the columns
+// that end up different, the flush blanks the rest
+void DisplayClearRow(unsigned char row)
+{
+    clearPending |= 1 << row;
+    DisplayMarkWritten(row, 0, SCREEN_COLUMN, false);
+}
+
+// Clear the whole display by setting all pixels to 0 (lazily, only what ends up different becomes dirty)
+void DisplayClear()
+{
+    unsigned char row;
+
+    BENCH_BEGIN(BENCH_CLEAR);
+    for (row = 0; row < SCREEN_ROW; row++)
+    {
+        DisplayClearRow(row);
+    }
+    BENCH_END(BENCH_CLEAR);
+}
+
+// Copy bank src over bank dst, only the columns that differ become dirty
+void DisplayCopyRow(unsigned char dst, unsigned char src)
+{
+    unsigned char start;
+    unsigned char end;
+    unsigned char* to = &frameBuffer[dst * SCREEN_COLUMN];
+    const unsigned char* from = &frameBuffer[src * SCREEN_COLUMN];
+
+    DisplayResolve(src);
+    DisplayResolve(dst);
+    for (start = 0; (start < SCREEN_COLUMN) && (to[start] == from[start]); start++);
+    if (start < SCREEN_COLUMN)
+    {
+        for (end = SCREEN_COLUMN; to[end - 1] == from[end - 1]; end--);
+        memcpy(to + start, from + start, end - start);
+        DisplayMarkDirty(dst, start, end);
+    }
+}
+
+// Move banks first..last one bank up (or down) and clear the bank left behind, ready for a new line of text
+void DisplayScrollRows(unsigned char first, unsigned char last, bool up)
+{
+    unsigned char row;
+    if (up)
+    {
+        for (row = first; row < last; row++)
+        {
+            DisplayCopyRow(row, row + 1);
+        }
+        DisplayClearRow(last);
+    }
+    else
+    {
+        for (row = last; row > first; row--)
+        {
+            DisplayCopyRow(row, row - 1);
+        }
+        DisplayClearRow(first);
+    }
+}
+
+// Flush job: one run of bytes per bank, [flushFrom, flushTo) as framebuffer positions, with the commands
+// that move the address pointer to flushFrom first (a run may start early in the bank before to skip them)
+#define FLUSH_SET_X 0x01
+#define FLUSH_SET_Y 0x02
+unsigned short flushFrom[SCREEN_ROW];
+unsigned short flushTo[SCREEN_ROW];
+unsigned char flushAddress[SCREEN_ROW];
+unsigned char flushRow = SCREEN_ROW;
+const unsigned char* flushBuffer;
+volatile bool flushBusy = false;
+
+#ifdef TELEMETRY
+#define DISPLAY_COUNT_BYTE() (telemetryDisplayBytes++)
+#else
+#define DISPLAY_COUNT_BYTE() ((void)0)
+#endif
+
+// Turn the dirty ranges into a flush job and mark the framebuffer clean, false when nothing changed
+bool DisplayFlushPlan()
+{
+    unsigned char row;
+    unsigned short pos;
+    unsigned short target;
+    bool any = false;
+
+    pos = displayY * SCREEN_COLUMN + displayX;
+    for (row = 0; row < SCREEN_ROW; row++)
+    {
+        DisplayResolve(row);
+        flushAddress[row] = 0;
+        flushFrom[row] = 0;
+        flushTo[row] = 0;
+        if (dirtyStart[row] != dirtyEnd[row])
+        {
+            target = row * SCREEN_COLUMN + dirtyStart[row];
+            // Re-sending a gap no longer than the set-address commands it replaces keeps the stream going
+            if ((displayX >= SCREEN_COLUMN) || (pos > target) || ((target - pos) > ((displayX != dirtyStart[row]) + (displayY != row))))
+            {
+                flushAddress[row] = ((displayX != dirtyStart[row]) ? FLUSH_SET_X : 0) | ((displayY != row) ? FLUSH_SET_Y : 0);
+                pos = target;
+            }
+            flushFrom[row] = pos;
+            flushTo[row] = row * SCREEN_COLUMN + dirtyEnd[row];
+            pos = flushTo[row];
+            // Where the controller pointer ends up (horizontal addressing wraps into the next bank and back to the top)
+            displayX = pos % SCREEN_COLUMN;
+            displayY = (pos / SCREEN_COLUMN) % SCREEN_ROW;
+            pos = displayY * SCREEN_COLUMN + displayX;
+            dirtyStart[row] = 0;
+            dirtyEnd[row] = 0;
+            any = true;
+        }
+    }
+    flushRow = 0;
+    return any;
+}
+
+#if DISPLAY_ISR_FLUSH
+// Send the next byte of the flush job, false once all of it was sent (the SPI complete interrupt asks for the
+// next one)
+bool DisplayFlushNext()
+{
+    for (; flushRow < SCREEN_ROW; flushRow++)
+    {
+        if (flushAddress[flushRow] & FLUSH_SET_X)
+        {
+            flushAddress[flushRow] &= ~FLUSH_SET_X;
+            spiWait();
+            IO_LOW(IO_CD);
+            spiPut(0x80 | (flushFrom[flushRow] % SCREEN_COLUMN));
+            DISPLAY_COUNT_BYTE();
+            return true;
+        }
+        if (flushAddress[flushRow] & FLUSH_SET_Y)
+        {
+            flushAddress[flushRow] &= ~FLUSH_SET_Y;
+            spiWait();
+            IO_LOW(IO_CD);
+            spiPut(0x40 | flushRow);
+            DISPLAY_COUNT_BYTE();
+            return true;
+        }
+        if (flushFrom[flushRow] < flushTo[flushRow])
+        {
+            spiWait();
+            IO_HIGH(IO_CD);
+            spiPut(flushBuffer[flushFrom[flushRow]++]);
+            DISPLAY_COUNT_BYTE();
+            return true;
+        }
+    }
+    return false;
+}
+
+// One byte went out, send the next one or stop when the job is done
+ISR(SPI_STC_vect)
+{
+    BENCH_BEGIN(BENCH_SPI_ISR);
+    if (!DisplayFlushNext())
+    {
+        SPCR &= ~(1 << SPIE);
+        flushBusy = false;
+    }
+    BENCH_END(BENCH_SPI_ISR);
+}
+#else
+// Send the whole flush job from the main loop: the address commands of a bank, then its run of bytes in one
+// loop (looking the job up again for every byte, as the interrupt has to, costs more than the byte on the wire)
+void DisplayFlushAll()
+{
+    unsigned char row;
+    const unsigned char* from;
+    const unsigned char* to;
+
+    for (row = 0; row < SCREEN_ROW; row++)
+    {
+        if (flushAddress[row] & FLUSH_SET_X)
+        {
+            DisplayCMD(0x80 | (flushFrom[row] % SCREEN_COLUMN));
+            DISPLAY_COUNT_BYTE();
+        }
+        if (flushAddress[row] & FLUSH_SET_Y)
+        {
+            DisplayCMD(0x40 | row);
+            DISPLAY_COUNT_BYTE();
+        }
+        flushAddress[row] = 0;
+        if (flushFrom[row] < flushTo[row])
+        {
+            from = flushBuffer + flushFrom[row];
+            to = flushBuffer + flushTo[row];
+            spiWait();
+            IO_HIGH(IO_CD);
+            do
+            {
+                spiWrite(*from++);
+                DISPLAY_COUNT_BYTE();
+            } while (from != to);
+            flushFrom[row] = flushTo[row];
+        }
+    }
+    flushRow = SCREEN_ROW;
+}
+#endif
+
+// A flush is still being sent
+bool DisplayBusy()
+{
+    return flushBusy;
+}
+
+// Something was drawn (or cleared) since the last flush
+bool DisplayDirty()
+{
+    unsigned char row;
+    if (clearPending != 0)
+    {
+        return true;
+    }
+    for (row = 0; row < SCREEN_ROW; row++)
+    {
+        if (dirtyStart[row] != dirtyEnd[row])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Send the changed parts of the framebuffer to the display
+// With the interrupt flush this only starts the transfer, while one is still running nothing happens and
+// the changes stay dirty for the next call (drawing may go on meanwhile: a byte changed after it was sent
+// is dirty again and goes out with the next flush)
+void DisplayFlush()
+{
+#if DISPLAY_DOUBLE_BUFFER
+    unsigned char row;
+#endif
+    if (flushBusy)
+    {
+        return;
+    }
+    BENCH_BEGIN(BENCH_FLUSH);
+    if (DisplayFlushPlan())
+    {
+        flushBuffer = frameBuffer;
+#if DISPLAY_DOUBLE_BUFFER
+        // Swap: the frame just finished is sent from the front buffer, the back buffer gets its changes so
+        // drawing carries on from the same picture
+        frameBuffer = (frameBuffer == frameBuffers[0]) ? frameBuffers[1] : frameBuffers[0];
+        for (row = 0; row < SCREEN_ROW; row++)
+        {
+            memcpy(frameBuffer + flushFrom[row], flushBuffer + flushFrom[row], flushTo[row] - flushFrom[row]);
+        }
+#endif
+#if DISPLAY_ISR_FLUSH
+        spiWait();                  // Clears SPIF of the last byte sent from the main loop
+        flushBusy = true;
+        DisplayFlushNext();
+        SPCR |= (1 << SPIE);        // The interrupt sends the rest
+#else
+        DisplayFlushAll();
+#endif
+    }
+    BENCH_END(BENCH_FLUSH);
+}
+
+// Initializing the display (needs a reset before sending commands by making reset pin low then high
+void DisplayInit()
+{
+    IO_WRITE(B, DISPLAY_PINS, 0);   // Set all pins low before setting as output
+    DDRB |= DISPLAY_PINS;           // Set all pins as output
+    _delay_ms(20);                  // Reset screen wait to go from low to high
+    IO_HIGH(IO_RST);                // Set Reset High to init screen
+    spiInit();                      // P_RST (SS) is an output now so SPI stays in master mode
+    DisplayCMD(0x21);               // Extended commands
+    DisplayCMD(0xA1);               // Set vop contrast
+    DisplayCMD(0x04);               // Set temp coefficient
+    DisplayCMD(0x14);               // Bias mode
+    DisplayCMD(0x20);               // Normal commands
+    DisplayCMD(0x0C);               // Normal display with horizontal address
+    displayX = 0xFF;                // Address pointer unknown until the first flush sets it
+    displayY = 0xFF;
+    DisplayInvalidate();            // Screen RAM holds garbage after reset, first flush sends everything
+}
+
+// Used for indexing columns in character sets (it skips 4 pixels to the right * the column you want to start at)
+bool colIndex = true;
+// Print a character into the framebuffer at column (character indexed not pixel indexed) and row
+void DisplayPrintChar(unsigned char row, unsigned char col, char letter)
+{
+    if (colIndex)
+    {
+        col += col * 4;
+    }
+    if (letter == 0x40 || !((letter >= 0x20) && (letter <= 0x7e)))
+    {
+        letter = '*';
+    }
+    if ((col < SCREEN_COLUMN) && (row < SCREEN_ROW))
+    {
+        unsigned char pixels;
+        const PROGMEM unsigned char* letterData = FONT + ((letter - 0x20) * 3);     // Missing ASCII will give * as result 
+
+        for (pixels = 0; (pixels < 3) && (col < SCREEN_COLUMN); pixels++, col++, letterData++)
+        {
+            unsigned char data = pgm_read_byte_near(letterData);    // Read byte from flash memory
+            DisplayWrite(row, col, data);
+        }
+        if (col < SCREEN_COLUMN)
+        {
+            DisplayWrite(row, col, 0x00);
+        }
+    }
+}
+
+// Index of a character in FONT_GLYPHS, characters without a glyph get the one of '*'
+unsigned char FontIndex(char letter)
+{
+    if (letter == 0x40 || !((letter >= 0x20) && (letter <= 0x7e)))
+    {
+        letter = '*';
+    }
+    return letter - 0x20;
+}
+
+// Columns a character of the proportional font takes, its blank column included (one table read, nothing drawn)
+unsigned char DisplayCharWidth(char letter)
+{
+    return GLYPH_WIDTH(pgm_read_word_near(&FONT_GLYPHS[FontIndex(letter)])) + 1;
+}
+
+// Print a character of the proportional font from pixel column x and return the column after its blank column
+unsigned char DisplayPrintGlyph(unsigned char row, unsigned char x, char letter)
+{
+    unsigned int glyph = pgm_read_word_near(&FONT_GLYPHS[FontIndex(letter)]);
+    const PROGMEM unsigned char* letterData = FONT_PROP + GLYPH_OFFSET(glyph);
+    unsigned char width = GLYPH_WIDTH(glyph);
+
+    for (; (width != 0) && (x < SCREEN_COLUMN); width--, x++, letterData++)
+    {
+        DisplayWrite(row, x, pgm_read_byte_near(letterData));
+    }
+    if (x < SCREEN_COLUMN)
+    {
+        DisplayWrite(row, x++, 0x00);
+    }
+    return x;
+}
+
+// Print a string in the proportional font from pixel column x and return the column after it, so pieces from
+// RAM and flash can follow each other on one line (No wrapping just clipping)
+unsigned char DisplayPrint(unsigned char row, unsigned char x, const char* string)
+{
+    for (; (*string != '\0') && (x < SCREEN_COLUMN); string++)
+    {
+        x = DisplayPrintGlyph(row, x, *string);
+    }
+    return x;
+}
+
+// Same as DisplayPrint for a string in flash
+unsigned char DisplayPrint_P(unsigned char row, unsigned char x, PGM_P string)
+{
+    char letter;
+    for (; ((letter = pgm_read_byte(string)) != '\0') && (x < SCREEN_COLUMN); string++)
+    {
+        x = DisplayPrintGlyph(row, x, letter);
+    }
+    return x;
+}
+
+// Print a line in the proportional font from character column col (No wrapping just clipping)
+void DisplayPrintLine(unsigned char row, unsigned char col, char* string)
+{
+	BENCH_BEGIN(BENCH_PRINT_LINE);
+	DisplayPrint(row, col + col * 4, string);
+	BENCH_END(BENCH_PRINT_LINE);
+}
+
+// Same as DisplayPrintLine for a string in flash, the characters go straight from flash to the framebuffer
+void DisplayPrintLine_P(unsigned char row, unsigned char col, PGM_P string)
+{
+    DisplayPrintSpan_P(row, col, string, 0xFF);
+}
+
+// Print at most length characters of a flash string, stopping early at the end of the string or a line break
+void DisplayPrintSpan_P(unsigned char row, unsigned char col, PGM_P string, unsigned char length)
+{
+	char letter;
+	BENCH_BEGIN(BENCH_PRINT_LINE);
+	col += col * 4;
+	for (; (length != 0) && ((letter = pgm_read_byte(string)) != '\0') && (letter != '\n') && (col < SCREEN_COLUMN); string++, length--)
+    {
+        col = DisplayPrintGlyph(row, col, letter);
+    }
+	BENCH_END(BENCH_PRINT_LINE);
+}
+
+// Print a character scale (2 or 3) times as large, spanning scale banks from row down and 4 * scale columns from
+// pixel column x (the glyph and its blank column), each column is looked up once and written scale times
+void DisplayPrintScaled(unsigned char row, unsigned char x, char letter, unsigned char scale)
+{
+    unsigned char pixels;
+    unsigned char repeat;
+    unsigned char band;
+    unsigned char data;
+    unsigned char banks[3];
+    const PROGMEM unsigned char* letterData;
+
+    if (letter == 0x40 || !((letter >= 0x20) && (letter <= 0x7e)))
+    {
+        letter = '*';
+    }
+    letterData = FONT + ((letter - 0x20) * 3);
+    for (pixels = 0; (pixels < 4) && (x < SCREEN_COLUMN); pixels++, letterData++)
+    {
+        data = (pixels < 3) ? pgm_read_byte_near(letterData) : 0x00;
+        if (scale == 2)
+        {
+            banks[0] = pgm_read_byte_near(&FONT_X2[data & 0x0F]);
+            banks[1] = pgm_read_byte_near(&FONT_X2[data >> 4]);
+        }
+        else
+        {
+            banks[0] = pgm_read_byte_near(&FONT_X3_TOP[data & 0x07]);
+            banks[1] = pgm_read_byte_near(&FONT_X3_MIDDLE[(data >> 2) & 0x0F]);
+            banks[2] = pgm_read_byte_near(&FONT_X3_BOTTOM[data >> 5]);
+        }
+        for (repeat = 0; (repeat < scale) && (x < SCREEN_COLUMN); repeat++, x++)
+        {
+            for (band = 0; (band < scale) && (row + band < SCREEN_ROW); band++)
+            {
+                DisplayWrite(row + band, x, banks[band]);
+            }
+        }
+    }
+}
+
+// Print a line centred at the largest scale up to maxScale whose width fits the screen and return that scale,
+// a line too long for 2x falls back to the normal font in bank row
+unsigned char DisplayPrintLarge(unsigned char row, const char* string, unsigned char maxScale)
+{
+    unsigned char length = strlen(string);
+    unsigned char scale = (maxScale > 3) ? 3 : maxScale;
+    unsigned int width;
+    unsigned char x;
+
+    // A line is 4 columns per character at scale 1, less the blank column after the last one
+    for (; (scale > 1) && ((length * 4U - 1) * scale > SCREEN_COLUMN); scale--);
+    width = length ? (length * 4U - 1) * scale : 0;
+    x = (width < SCREEN_COLUMN) ? (SCREEN_COLUMN - width) / 2 : 0;
+    if (scale <= 1)
+    {
+        colIndex = false;
+        for (; (*string != '\0') && (x < SCREEN_COLUMN); x += 4, string++)
+        {
+            DisplayPrintChar(row, x, *string);
+        }
+        colIndex = true;
+        return 1;
+    }
+    for (; (*string != '\0') && (x < SCREEN_COLUMN); x += 4 * scale, string++)
+    {
+        DisplayPrintScaled(row, x, *string, scale);
+    }
+    return scale;
+}
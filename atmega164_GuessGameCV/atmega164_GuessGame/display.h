@@ -0,0 +1,59 @@
+/*
+ * display.h
+ *
+ * PCD8544 driver: framebuffer, dirty-range flushing and text printing (fixed cells and a proportional font).
+ */
+
+#ifndef DISPLAY_H_
+#define DISPLAY_H_
+
+#include <stdbool.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#include "config.h"
+#include "gpio.h"
+
+// Every display pin, all of them are on PORTB
+#define DISPLAY_PINS (IO_MASK(IO_SCK) | IO_MASK(IO_COPI) | IO_MASK(IO_RST) | IO_MASK(IO_CD))
+
+// A second framebuffer lets the next frame be drawn while the last one is sent, the two need 1008 bytes so
+// only parts with 2 KB of SRAM or more get it (the ATmega164A has 1 KB and draws into the buffer being sent)
+#ifndef DISPLAY_DOUBLE_BUFFER
+#if (RAMEND - RAMSTART + 1) >= 2048
+#define DISPLAY_DOUBLE_BUFFER 1
+#else
+#define DISPLAY_DOUBLE_BUFFER 0
+#endif
+#endif
+
+extern const PROGMEM unsigned char FONT[];
+extern unsigned char* frameBuffer;
+
+void DisplayCMD(unsigned char cmd);
+void DisplayMarkDirty(unsigned char row, unsigned char start, unsigned char end);
+bool DisplayPending(unsigned char row);
+unsigned char DisplayBase(unsigned char row, unsigned char col);
+void DisplayInvalidate();
+void DisplayWrite(unsigned char row, unsigned char col, unsigned char data);
+void DisplayInvert(unsigned char row, unsigned char start, unsigned char end);
+void DisplayClearRow(unsigned char row);
+void DisplayClear();
+void DisplayCopyRow(unsigned char dst, unsigned char src);
+void DisplayScrollRows(unsigned char first, unsigned char last, bool up);
+void DisplayFlush();
+bool DisplayBusy();
+bool DisplayDirty();
+void DisplayInit();
+void DisplayPrintChar(unsigned char row, unsigned char col, char letter);
+unsigned char DisplayCharWidth(char letter);
+unsigned char DisplayPrintGlyph(unsigned char row, unsigned char x, char letter);
+unsigned char DisplayPrint(unsigned char row, unsigned char x, const char* string);
+unsigned char DisplayPrint_P(unsigned char row, unsigned char x, PGM_P string);
+void DisplayPrintLine(unsigned char row, unsigned char col, char* string);
+void DisplayPrintLine_P(unsigned char row, unsigned char col, PGM_P string);
+void DisplayPrintSpan_P(unsigned char row, unsigned char col, PGM_P string, unsigned char length);
+void DisplayPrintScaled(unsigned char row, unsigned char x, char letter, unsigned char scale);
+unsigned char DisplayPrintLarge(unsigned char row, const char* string, unsigned char maxScale);
+
+#endif /* DISPLAY_H_ */
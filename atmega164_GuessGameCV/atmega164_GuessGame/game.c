@@ -0,0 +1,110 @@
+/*
+ * game.c
+ *
+ * Word dictionary and the rules of one round.
+ */
+
+#include <stdbool.h>
+#include <avr/pgmspace.h>
+
+#include "game.h"
+#include "dictionary.h"
+
+#if DICT_LENGTH_MAX > WORD_MAX
+#error "words.txt has words longer than WORD_MAX"
+#endif
+
+// Number of words in the dictionary
+unsigned int DictCount()
+{
+	return DICT_WORD_COUNT;
+}
+
+// Words of one length: returns how many there are and their first word number in *first
+unsigned int DictBucket(unsigned char length, unsigned int *first)
+{
+	if((length < DICT_LENGTH_MIN) || (length > DICT_LENGTH_MAX))
+	{
+		*first = 0;
+		return 0;
+	}
+	length -= DICT_LENGTH_MIN;
+	*first = pgm_read_word(&DICT_BUCKET_FIRST[length]);
+	return pgm_read_word(&DICT_BUCKET_FIRST[length + 1]) - *first;
+}
+
+// Decode word number index (0 to DICT_WORD_COUNT - 1) of the packed dictionary into word, returns its length
+unsigned char DictWord(unsigned int index, char *word)
+{
+	unsigned char bucket = 0;
+	unsigned char length;
+	unsigned char i;
+	unsigned char count;
+	unsigned int bits;
+	unsigned long start;
+	const unsigned char *data;
+
+	// Bucket lookup, at most one step per word length
+	while(index >= pgm_read_word(&DICT_BUCKET_FIRST[bucket + 1]))
+	{
+		bucket++;
+	}
+	length = DICT_LENGTH_MIN + bucket;
+	// All words of a bucket have the same length so the start bit is a multiplication away
+	start = (unsigned long)(index - pgm_read_word(&DICT_BUCKET_FIRST[bucket])) * (length * 5);
+	data = DICT_DATA + pgm_read_word(&DICT_BUCKET_OFFSET[bucket]) + (unsigned int)(start >> 3);
+	bits = pgm_read_byte(data++) >> (start & 7);
+	count = 8 - (start & 7);
+	for(i = 0; i < length; i++)
+	{
+		if(count < 5)
+		{
+			bits |= (unsigned int)pgm_read_byte(data++) << count;
+			count += 8;
+		}
+		word[i] = 'A' + (bits & 0x1F);
+		bits >>= 5;
+		count -= 5;
+	}
+	word[length] = '\0';
+	return length;
+}
+
+// Start a round with word number index of the dictionary, decoded straight into the round
+void GameStart(Game *round, unsigned int index)
+{
+	unsigned char i;
+	round->length = DictWord(index, round->word);
+	round->index = index;
+	round->letters = 0;
+	for(i = 0; i < round->length; i++)
+	{
+		round->letters |= LETTER_BIT(round->word[i]);
+	}
+	round->guessed = 0;
+	round->strikes = 0;
+}
+
+// Guess a letter, a letter not in the word is a strike (every time it is picked), returns true for a hit
+bool GameGuess(Game *round, char letter)
+{
+	unsigned long bit = LETTER_BIT(letter);
+	if(round->letters & bit)
+	{
+		round->guessed |= bit;
+		return true;
+	}
+	round->strikes++;
+	return false;
+}
+
+// Every letter of the word was found
+bool GameWon(const Game *round)
+{
+	return round->guessed == round->letters;
+}
+
+bool GameLost(const Game *round)
+{
+	return round->strikes >= STRIKES_MAX;
+}
@@ -0,0 +1,37 @@
+/*
+ * game.h
+ *
+ * Word dictionary and the rules of one round.
+ */
+
+#ifndef GAME_H_
+#define GAME_H_
+
+#include <stdbool.h>
+
+// Most letters a word may have (it has to fit on one row) and strikes that lose the game
+#define WORD_MAX 16
+#define STRIKES_MAX 6
+// Bit of an upper case letter in the letter masks, 'A' is bit 0
+#define LETTER_BIT(letter) (1UL << ((letter) - 'A'))
+
+// One round: the word plus which letters it has and which of those were found
+typedef struct
+{
+	char word[WORD_MAX + 1];
+	unsigned char length;
+	unsigned int index;         // Dictionary index of the word
+	unsigned long letters;      // Letters that occur in the word
+	unsigned long guessed;      // Letters of the word that were guessed
+	unsigned char strikes;
+} Game;
+
+unsigned int DictCount();
+unsigned int DictBucket(unsigned char length, unsigned int *first);
+unsigned char DictWord(unsigned int index, char *word);
+void GameStart(Game *round, unsigned int index);
+bool GameGuess(Game *round, char letter);
+bool GameWon(const Game *round);
+bool GameLost(const Game *round);
+
+#endif /* GAME_H_ */
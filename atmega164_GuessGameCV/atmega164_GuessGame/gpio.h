@@ -0,0 +1,33 @@
+/*
+ * gpio.h
+ *
+ * Compile-time pin operations on the (port, bit) descriptors from config.h.
+ */
+
+#ifndef GPIO_H_
+#define GPIO_H_
+
+#include "config.h"
+
+// Pin operations resolved at compile time, each one becomes a single sbi/cbi/sbis instruction
+// Ex: IO_HIGH(IO_CD), if(IO_READ(IO_UP))
+#define IO_HIGH(pin)    IO_HIGH_(pin)
+#define IO_LOW(pin)     IO_LOW_(pin)
+#define IO_TOGGLE(pin)  IO_TOGGLE_(pin)
+#define IO_READ(pin)    IO_READ_(pin)
+#define IO_OUTPUT(pin)  IO_OUTPUT_(pin)
+#define IO_INPUT(pin)   IO_INPUT_(pin)
+#define IO_MASK(pin)    IO_MASK_(pin)
+#define IO_HIGH_(port, bit)    (PORT##port |= (1 << (bit)))
+#define IO_LOW_(port, bit)     (PORT##port &= ~(1 << (bit)))
+#define IO_TOGGLE_(port, bit)  (PIN##port = (1 << (bit)))     // Writing 1 to PINx toggles the PORTx bit
+#define IO_READ_(port, bit)    ((PIN##port & (1 << (bit))) != 0)
+#define IO_OUTPUT_(port, bit)  (DDR##port |= (1 << (bit)))
+#define IO_INPUT_(port, bit)   (DDR##port &= ~(1 << (bit)))
+#define IO_MASK_(port, bit)    (1 << (bit))
+
+// Several pins of one port at once: only the bits in mask take the matching bits of value
+// Ex: IO_WRITE(B, IO_MASK(IO_CD) | IO_MASK(IO_RST), IO_MASK(IO_RST))
+#define IO_WRITE(port, mask, value)  (PORT##port = (PORT##port & ~(mask)) | ((value) & (mask)))
+
+#endif /* GPIO_H_ */
@@ -0,0 +1,225 @@
+/*
+ * graphics.c
+ *
+ * Pixel drawing into the framebuffer: lines, rectangles and flash bitmaps.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+
+#include "display.h"
+#include "graphics.h"
+
+// Combine bits into the byte of a bank at column col, true when the byte changed
+bool GfxPut(unsigned char row, unsigned char col, unsigned char bits, unsigned char mode)
+{
+    unsigned char* pixels = &frameBuffer[row * SCREEN_COLUMN + col];
+    unsigned char value = DisplayBase(row, col);     // Blank when the bank waits for its clear
+    if (mode == GFX_SET)
+    {
+        value |= bits;
+    }
+    else if (mode == GFX_CLEAR)
+    {
+        value &= ~bits;
+    }
+    else
+    {
+        value ^= bits;
+    }
+    if (value == *pixels)
+    {
+        return false;
+    }
+    *pixels = value;
+    return true;
+}
+
+// Apply the same bits to the columns start..end of a bank, only the columns that change become dirty
+// Whole bytes set or cleared are one memset after skipping the columns that already hold the value
+void GfxSpan(unsigned char row, unsigned char start, unsigned char end, unsigned char bits, unsigned char mode)
+{
+    unsigned char* bank = &frameBuffer[row * SCREEN_COLUMN];
+    bool pending = DisplayPending(row);
+    unsigned char value;
+    unsigned char keep;
+    unsigned char flip;
+    unsigned char first;
+    unsigned char last;
+
+    if ((bits == 0xFF) && (mode != GFX_XOR) && !pending)
+    {
+        value = (mode == GFX_SET) ? 0xFF : 0x00;
+        for (; (start < end) && (bank[start] == value); start++);
+        if (start < end)
+        {
+            for (; bank[end - 1] == value; end--);
+            memset(bank + start, value, end - start);
+            DisplayMarkDirty(row, start, end);
+        }
+        return;
+    }
+    // new = (old & keep) ^ flip covers all three modes without a branch per column
+    keep = (mode == GFX_XOR) ? 0xFF : (unsigned char)~bits;
+    flip = (mode == GFX_CLEAR) ? 0x00 : bits;
+    first = end;
+    last = start;
+    for (; start < end; start++)
+    {
+        value = ((pending ? DisplayBase(row, start) : bank[start]) & keep) ^ flip;
+        if (value != bank[start])
+        {
+            bank[start] = value;
+            if (first > start)
+            {
+                first = start;
+            }
+            last = start + 1;
+        }
+    }
+    if (first < last)
+    {
+        DisplayMarkDirty(row, first, last);
+    }
+}
+
+// Draw one pixel, x 0..SCREEN_COLUMN-1 from the left and y 0..SCREEN_HEIGHT-1 from the top
+void GfxPixel(unsigned char x, unsigned char y, unsigned char mode)
+{
+    if ((x < SCREEN_COLUMN) && (y < SCREEN_HEIGHT))
+    {
+        if (GfxPut(y >> 3, x, 1 << (y & 7), mode))
+        {
+            DisplayMarkDirty(y >> 3, x, x + 1);
+        }
+    }
+}
+
+// Horizontal line: one bit in every column of a single bank
+void GfxHLine(unsigned char x, unsigned char y, unsigned char width, unsigned char mode)
+{
+    GfxRect(x, y, width, 1, mode);
+}
+
+// Vertical line: whole bytes for the banks it fills, a mask for the banks it starts and ends in
+void GfxVLine(unsigned char x, unsigned char y, unsigned char height, unsigned char mode)
+{
+    GfxRect(x, y, 1, height, mode);
+}
+
+// Filled rectangle, clipped to the screen, drawn bank by bank with the bits it covers in each
+void GfxRect(unsigned char x, unsigned char y, unsigned char width, unsigned char height, unsigned char mode)
+{
+    unsigned char row;
+    unsigned char bottom;
+    unsigned char bits;
+
+    if ((x >= SCREEN_COLUMN) || (y >= SCREEN_HEIGHT) || (width == 0) || (height == 0))
+    {
+        return;
+    }
+    if (width > SCREEN_COLUMN - x)
+    {
+        width = SCREEN_COLUMN - x;
+    }
+    if (height > SCREEN_HEIGHT - y)
+    {
+        height = SCREEN_HEIGHT - y;
+    }
+    bottom = y + height;
+    for (row = y >> 3; (row << 3) < bottom; row++)
+    {
+        bits = 0xFF;
+        if ((row << 3) < y)
+        {
+            bits <<= y & 7;                             // Pixels above the rectangle stay
+        }
+        if (((row + 1) << 3) > bottom)
+        {
+            bits &= 0xFF >> (((row + 1) << 3) - bottom);   // And the ones below it
+        }
+        GfxSpan(row, x, x + width, bits, mode);
+    }
+}
+
+// Outline of a rectangle, one pixel wide (with XOR the corners are flipped once)
+void GfxFrame(unsigned char x, unsigned char y, unsigned char width, unsigned char height, unsigned char mode)
+{
+    if ((width <= 2) || (height <= 2))
+    {
+        GfxRect(x, y, width, height, mode);     // Nothing inside, the outline is the whole rectangle
+        return;
+    }
+    GfxHLine(x, y, width, mode);
+    GfxHLine(x, y + height - 1, width, mode);
+    GfxVLine(x, y + 1, height - 2, mode);
+    GfxVLine(x + width - 1, y + 1, height - 2, mode);
+}
+
+// Draw a 1 bit per pixel bitmap from flash with its top left corner at x, y, clipped to the screen
+// The bitmap is laid out like the framebuffer and FONT: (height + 7) / 8 bands of width column bytes, bit 0 on top
+// With y a multiple of 8 every byte lands in one bank, otherwise it is split over the bank and the one below
+void GfxBitmap_P(unsigned char x, unsigned char y, const unsigned char* bitmap, unsigned char width, unsigned char height, unsigned char mode)
+{
+    unsigned char bands = (height + 7) >> 3;
+    unsigned char shift = y & 7;
+    unsigned char row = y >> 3;
+    unsigned char columns;
+    unsigned char band;
+    unsigned char col;
+    unsigned char bits;
+    unsigned int spread;
+    bool below;
+    unsigned char first[2];
+    unsigned char last[2];
+
+    if ((x >= SCREEN_COLUMN) || (y >= SCREEN_HEIGHT))
+    {
+        return;
+    }
+    columns = (width > SCREEN_COLUMN - x) ? (SCREEN_COLUMN - x) : width;
+    for (band = 0; (band < bands) && (row < SCREEN_ROW); band++, row++, bitmap += width)
+    {
+        below = shift && (row + 1 < SCREEN_ROW);
+        first[0] = first[1] = columns;
+        last[0] = last[1] = 0;
+        for (col = 0; col < columns; col++)
+        {
+            bits = pgm_read_byte(bitmap + col);
+            if ((band == bands - 1) && (height & 7))
+            {
+                bits &= 0xFF >> (8 - (height & 7));     // Padding bits of the last band
+            }
+            if (bits == 0)
+            {
+                continue;
+            }
+            spread = (unsigned int)bits << shift;
+            if (GfxPut(row, x + col, (unsigned char)spread, mode))
+            {
+                if (first[0] > col)
+                {
+                    first[0] = col;
+                }
+                last[0] = col + 1;
+            }
+            if (below && (spread >> 8) && GfxPut(row + 1, x + col, spread >> 8, mode))
+            {
+                if (first[1] > col)
+                {
+                    first[1] = col;
+                }
+                last[1] = col + 1;
+            }
+        }
+        if (first[0] < last[0])
+        {
+            DisplayMarkDirty(row, x + first[0], x + last[0]);
+        }
+        if (first[1] < last[1])
+        {
+            DisplayMarkDirty(row + 1, x + first[1], x + last[1]);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+/*
+ * graphics.h
+ *
+ * Pixel drawing into the framebuffer: lines, rectangles and flash bitmaps.
+ */
+
+#ifndef GRAPHICS_H_
+#define GRAPHICS_H_
+
+#include <avr/pgmspace.h>
+
+#include "config.h"
+
+// Pixel rows of the screen, a bank holds 8 of them with bit 0 on top
+#define SCREEN_HEIGHT (SCREEN_ROW * 8)
+
+// How drawn pixels are combined with the framebuffer
+#define GFX_SET   0     // Light them
+#define GFX_CLEAR 1     // Blank them
+#define GFX_XOR   2     // Flip them, drawing the same thing twice restores the screen
+
+void GfxPixel(unsigned char x, unsigned char y, unsigned char mode);
+void GfxHLine(unsigned char x, unsigned char y, unsigned char width, unsigned char mode);
+void GfxVLine(unsigned char x, unsigned char y, unsigned char height, unsigned char mode);
+void GfxRect(unsigned char x, unsigned char y, unsigned char width, unsigned char height, unsigned char mode);
+void GfxFrame(unsigned char x, unsigned char y, unsigned char width, unsigned char height, unsigned char mode);
+void GfxBitmap_P(unsigned char x, unsigned char y, const unsigned char* bitmap, unsigned char width, unsigned char height, unsigned char mode);
+
+#endif /* GRAPHICS_H_ */
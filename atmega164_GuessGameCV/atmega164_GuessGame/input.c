@@ -0,0 +1,129 @@
+/*
+ * input.c
+ *
+ * Button driver: pin-change wake up, tick-driven debounce and an event queue.
+ */
+
+#include <stdbool.h>
+#include <avr/interrupt.h>
+
+#include "input.h"
+#include "timer.h"
+#include "uart.h"
+
+// Single producer (tick ISR) single consumer (main loop) ring buffer, the indexes are bytes so updates are atomic
+unsigned char eventQueue[EVENT_QUEUE_SIZE];
+volatile unsigned char eventHead = 0;
+volatile unsigned char eventTail = 0;
+
+// Debounce state, only touched inside the tick ISR once started
+volatile bool buttonScan = false;               // Set by the pin change ISR, cleared once every key is released and settled
+unsigned char buttonIntegrator[BUTTON_COUNT];   // 0 = released, DEBOUNCE_MS = pressed
+unsigned char buttonState = 0;                  // Debounced pressed keys as a PIND mask
+unsigned int buttonRepeat[BUTTON_COUNT];        // ms until the next repeat event of a held key
+
+// Tick of the pin change that started the current scan, for measuring wake-to-render latency
+volatile unsigned int wakeTick = 0;
+volatile bool wakePending = false;
+
+// Queue an event, dropped when the main loop fell EVENT_QUEUE_SIZE - 1 events behind
+void EventPut(unsigned char event)
+{
+    unsigned char head = eventHead;
+    unsigned char next = (head + 1) & (EVENT_QUEUE_SIZE - 1);
+    if (next != eventTail)
+    {
+        eventQueue[head] = event;
+        eventHead = next;
+    }
+}
+
+// Take the oldest event, returns false when there is none
+bool EventGet(unsigned char *event)
+{
+    unsigned char tail = eventTail;
+    if (tail == eventHead)
+    {
+        return false;
+    }
+    *event = eventQueue[tail];
+    eventTail = (tail + 1) & (EVENT_QUEUE_SIZE - 1);
+    return true;
+}
+
+// Events are waiting for the main loop
+bool EventPending()
+{
+    return eventTail != eventHead;
+}
+
+// Sample the buttons once per tick, every key is integrated on its own so simultaneous presses all get events
+void ButtonScan()
+{
+    unsigned char raw = ~PIND & BUTTON_MASK;
+    unsigned char key;
+    unsigned char busy;
+#ifdef TELEMETRY
+    if (UCSR0B & (1 << TXEN0))
+    {
+        raw = (raw & ~IO_MASK(IO_RGT)) | (buttonState & IO_MASK(IO_RGT));    // The transmitter drives PD1, keep the key as it was
+    }
+#endif
+    busy = raw;
+
+    for (key = 0; key < BUTTON_COUNT; key++)
+    {
+        unsigned char mask = (1 << key);
+        if (raw & mask)
+        {
+            if (buttonIntegrator[key] < DEBOUNCE_MS)
+            {
+                buttonIntegrator[key]++;
+                if ((buttonIntegrator[key] == DEBOUNCE_MS) && !(buttonState & mask))
+                {
+                    buttonState |= mask;
+                    buttonRepeat[key] = REPEAT_DELAY_MS;
+                    EventPut(EVENT_PRESS | key);
+                }
+            }
+            else if (--buttonRepeat[key] == 0)
+            {
+                buttonRepeat[key] = REPEAT_PERIOD_MS;
+                EventPut(EVENT_REPEAT | key);
+            }
+        }
+        else if (buttonIntegrator[key] > 0)
+        {
+            buttonIntegrator[key]--;
+            if ((buttonIntegrator[key] == 0) && (buttonState & mask))
+            {
+                buttonState &= ~mask;
+                EventPut(EVENT_RELEASE | key);
+            }
+        }
+        busy |= buttonIntegrator[key];
+    }
+    if (busy == 0)
+    {
+        buttonScan = false;     // All released and settled, the next edge restarts scanning
+    }
+}
+
+// Pin change on PD0-PD3 starts the debounce scan in the tick ISR
+ISR(PCINT3_vect)
+{
+    if (!buttonScan)
+    {
+        wakeTick = tickCount;   // First edge after the keys were idle, this is what woke the CPU
+        wakePending = true;
+    }
+    buttonScan = true;
+}
+
+void initInput()
+{
+	DDRD &= ~BUTTON_MASK;               // Buttons as inputs
+	IO_WRITE(D, BUTTON_MASK, 0xFF);     // with pull-ups
+	PCMSK3 = (1 << PCINT24) | (1 << PCINT25) | (1 << PCINT26) | (1 << PCINT27);   // PD0-PD3
+	PCICR |= (1 << PCIE3);
+}
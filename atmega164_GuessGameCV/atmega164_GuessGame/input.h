@@ -0,0 +1,39 @@
+/*
+ * input.h
+ *
+ * Button driver: pin-change wake up, tick-driven debounce and an event queue.
+ */
+
+#ifndef INPUT_H_
+#define INPUT_H_
+
+#include <stdbool.h>
+
+#include "gpio.h"
+
+// Buttons on PD0-PD3 (PCINT24-27), pressed = pin pulled low
+#define BUTTON_MASK (IO_MASK(IO_UP) | IO_MASK(IO_RGT) | IO_MASK(IO_LFT) | IO_MASK(IO_DWN))
+#define BUTTON_COUNT 4
+#define DEBOUNCE_MS 5           // Samples a key must read the same before its state changes
+#define REPEAT_DELAY_MS 300     // Hold time before the first repeat
+#define REPEAT_PERIOD_MS 60     // Time between repeats while held
+
+// Input events: type in the high nibble, key (the PIND bit number) in the low nibble
+#define EVENT_PRESS   0x10
+#define EVENT_RELEASE 0x20
+#define EVENT_REPEAT  0x30
+#define EVENT_TYPE_MASK 0xF0
+#define EVENT_KEY_MASK  0x0F
+#define EVENT_QUEUE_SIZE 16     // Power of 2, one slot stays empty to tell full from empty
+
+extern volatile bool buttonScan;
+extern volatile unsigned int wakeTick;
+extern volatile bool wakePending;
+
+void initInput();
+void EventPut(unsigned char event);
+bool EventGet(unsigned char *event);
+bool EventPending();
+void ButtonScan();
+
+#endif /* INPUT_H_ */
@@ -0,0 +1,142 @@
+/*
+ * random.c
+ *
+ * xorshift random numbers seeded from watchdog jitter, and a shuffle bag that never repeats before it runs out.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+#include "random.h"
+
+// Galois LFSR feedback with a full period for every width from 2 to 16 bits
+const PROGMEM unsigned int LFSR_TAPS[] = {
+    0x0003, 0x0006, 0x000C, 0x0014, 0x0030, 0x0060, 0x00B8,
+    0x0110, 0x0240, 0x0500, 0x0829, 0x100D, 0x2015, 0x6000, 0xD008,
+};
+
+// Timer0 counts collected by the watchdog interrupt
+volatile unsigned int entropyPool = 0;
+volatile unsigned char entropySamples = 0;
+
+// xorshift state, never 0
+unsigned int randomState = 1;
+
+// The watchdog runs from its own 128 kHz RC oscillator, so where Timer0 is when it fires drifts with
+// temperature, supply and part
+ISR(WDT_vect)
+{
+    entropyPool = ((entropyPool << 3) | (entropyPool >> 13)) ^ TCNT0;
+    if (++entropySamples >= ENTROPY_SAMPLES)
+    {
+        WDTCSR = 0;     // Interrupt mode off, the watchdog no longer wakes the CPU
+    }
+}
+
+// Start sampling watchdog jitter (Timer0 must be running), interrupt mode only so it never resets the part
+void EntropyInit()
+{
+    MCUSR &= ~(1 << WDRF);
+    WDTCSR = (1 << WDCE) | (1 << WDE);
+    WDTCSR = (1 << WDIE);       // 16 ms period
+}
+
+// True until the watchdog has delivered all ENTROPY_SAMPLES, the CPU must not go below idle until then:
+// Timer0 stops in power-down and every sample taken there would read the same TCNT0
+bool EntropyBusy()
+{
+    return entropySamples < ENTROPY_SAMPLES;
+}
+
+// Mix more entropy into the generator, e.g. the tick of a button press
+void RandomStir(unsigned int entropy)
+{
+    randomState ^= entropy;
+    if (randomState == 0)
+    {
+        randomState = 0xACE1;
+    }
+    RandomNext();
+}
+
+// xorshift16 (7, 9, 8), period 65535 with only shifts and XORs
+unsigned int RandomNext()
+{
+    randomState ^= randomState << 7;
+    randomState ^= randomState >> 9;
+    randomState ^= randomState << 8;
+    return randomState;
+}
+
+// Unbiased value in 0..bound-1 without a division: draws outside the smallest covering power of two are redrawn
+unsigned int RandomBelow(unsigned int bound)
+{
+    unsigned int mask = 0;
+    unsigned int value;
+    if (bound < 2)
+    {
+        return 0;
+    }
+    while (mask < bound - 1)
+    {
+        mask = (mask << 1) | 1;
+    }
+    do
+    {
+        value = RandomNext() & mask;
+    } while (value >= bound);
+    return value;
+}
+
+// Empty bag for the values 0..count-1 (count from 1), the first BagNext() fills it
+void BagInit(ShuffleBag *bag, unsigned int count)
+{
+    unsigned char width = 2;
+    while ((width < 16) && ((1U << width) < count))
+    {
+        width++;
+    }
+    bag->count = count;
+    bag->taps = pgm_read_word(&LFSR_TAPS[width - 2]);
+    bag->size = (width < 16) ? ((1U << width) - 1) : 0xFFFF;
+    bag->state = 1;
+    bag->mask = 0;
+    bag->left = 0;
+}
+
+// Next value of the bag, every value comes out once before any repeats
+// The LFSR states are 1..2^width-1, XOR with the pass mask turns them into every value but the mask itself,
+// which is handed out at the start of the pass
+unsigned int BagNext(ShuffleBag *bag)
+{
+    unsigned int value;
+    do
+    {
+        if (bag->left == 0)
+        {
+            // New pass: random start and mask, the mask itself comes first
+            bag->mask = RandomNext() & bag->size;
+            do
+            {
+                bag->state = RandomNext() & bag->size;
+            } while (bag->state == 0);
+            bag->left = bag->size;
+            value = bag->mask;
+        }
+        else
+        {
+            if (bag->state & 1)
+            {
+                bag->state = (bag->state >> 1) ^ bag->taps;
+            }
+            else
+            {
+                bag->state >>= 1;
+            }
+            bag->left--;
+            value = bag->state ^ bag->mask;
+        }
+    } while (value >= bag->count);
+    return value;
+}
@@ -0,0 +1,36 @@
+/*
+ * random.h
+ *
+ * xorshift random numbers seeded from watchdog jitter, and a shuffle bag that never repeats before it runs out.
+ */
+
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include <stdbool.h>
+
+// Watchdog periods sampled after boot before the watchdog is switched off again (16 ms each)
+#define ENTROPY_SAMPLES 32
+
+// Order of a shuffle bag: a maximal LFSR walks every non-zero state once, values outside the bag are skipped
+typedef struct
+{
+    unsigned int count;     // Values 0..count-1
+    unsigned int taps;      // LFSR feedback for the smallest width that holds count
+    unsigned int size;      // 2^width - 1 states
+    unsigned int state;
+    unsigned int mask;      // XOR applied to the states, a new one every pass
+    unsigned int left;      // States still to walk in this pass
+} ShuffleBag;
+
+extern volatile unsigned int entropyPool;
+
+void EntropyInit();
+bool EntropyBusy();
+void RandomStir(unsigned int entropy);
+unsigned int RandomNext();
+unsigned int RandomBelow(unsigned int bound);
+void BagInit(ShuffleBag *bag, unsigned int count);
+unsigned int BagNext(ShuffleBag *bag);
+
+#endif /* RANDOM_H_ */
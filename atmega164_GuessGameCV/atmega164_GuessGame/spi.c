@@ -0,0 +1,81 @@
+/*
+ * spi.c
+ *
+ * Hardware SPI transport for the PCD8544, with the bit-banged version as fallback.
+ */
+
+#include <stdbool.h>
+
+#include "gpio.h"
+#include "spi.h"
+
+// The USART SPI mode can't be used here because XCK0/XCK1 sit on the button pins of PORTD
+
+#if DISPLAY_HW_SPI
+
+// Set when a byte was written to SPDR and the transfer may still be shifting out
+bool spiPending = false;
+
+// Hardware SPI setup, master mode 0 MSB first at F_CPU/SPI_DIVIDER (SS is PB4 = P_RST so it is already an output)
+void spiInit()
+{
+    SPCR = (1 << SPE) | (1 << MSTR) | SPI_SPCR_BITS;
+    SPSR = SPI_SPSR_BITS;
+    spiPending = false;
+}
+
+// Wait for the last byte to leave the shift register (needed before touching CD)
+void spiWait()
+{
+    if (spiPending)
+    {
+        while ((SPSR & (1 << SPIF)) == 0);
+        spiPending = false;
+    }
+}
+
+// Hardware SPI method (does not wait, the next byte or CD change waits instead so the CPU can work meanwhile)
+void spiWrite(unsigned char data)
+{
+    spiWait();
+    SPDR = data;
+    spiPending = true;
+}
+
+// Start a byte and return, the SPI complete interrupt reports the end of the transfer (only used by the interrupt flush)
+void spiPut(unsigned char data)
+{
+    SPDR = data;
+}
+
+#else
+
+void spiInit()
+{
+}
+
+void spiWait()
+{
+}
+
+// Software SPI method
+void spiWrite(unsigned char data)
+{
+    unsigned char i;
+    for (i = 0; i < 8; i++)
+    {
+        if (data & 0x80)    // Compare data to 1000 0000 (MSB)
+        {
+            IO_HIGH(IO_COPI);   // Set high
+        }
+        else
+        {
+            IO_LOW(IO_COPI);    // Set low
+        }
+        IO_HIGH(IO_SCK);       // Clock high for write
+        IO_LOW(IO_SCK);        // Clock low for next write
+        data <<= 1;     // Shift data to next bit to write
+    }
+}
+
+#endif
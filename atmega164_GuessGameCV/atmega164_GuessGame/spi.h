@@ -0,0 +1,38 @@
+/*
+ * spi.h
+ *
+ * Byte transport to the display controller.
+ */
+
+#ifndef SPI_H_
+#define SPI_H_
+
+#include "clock.h"
+
+// Display transport selection (1 = hardware SPI at F_CPU/SPI_DIVIDER, 0 = software SPI fallback)
+#ifndef DISPLAY_HW_SPI
+#define DISPLAY_HW_SPI 1
+#endif
+
+// CPU cycles of one SPI complete interrupt of the flush: entry and exit plus one DisplayFlushNext step
+// (the bench section BENCH_SPI_ISR measures the part between the markers)
+#define DISPLAY_ISR_CYCLES 80
+
+// Framebuffer flush in the background from the SPI complete interrupt (needs the hardware SPI)
+// A byte takes 8 * SPI_DIVIDER cycles, at F_CPU/2 that is 16 and the interrupt costs several times more than
+// the blocking loop it replaces, so it is only used once the interrupt takes at most half of a byte time
+// (e.g. -DDISPLAY_SPI_MAX_HZ=31250UL at 1 MHz gives F_CPU/32, 256 cycles a byte)
+#ifndef DISPLAY_ISR_FLUSH
+#if DISPLAY_HW_SPI && ((8 * SPI_DIVIDER) >= (2 * DISPLAY_ISR_CYCLES))
+#define DISPLAY_ISR_FLUSH 1
+#else
+#define DISPLAY_ISR_FLUSH 0
+#endif
+#endif
+
+void spiInit();
+void spiWait();
+void spiWrite(unsigned char data);
+void spiPut(unsigned char data);
+
+#endif /* SPI_H_ */
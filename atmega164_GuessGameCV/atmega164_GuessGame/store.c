@@ -0,0 +1,105 @@
+/*
+ * store.c
+ *
+ * Game state and statistics in EEPROM: a ring of CRC checked records written in the background.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+
+#include "store.h"
+
+// Slot of the newest record and its sequence number, the next write goes to the slot after it
+unsigned char storeSlot = STORE_SLOTS - 1;
+unsigned char storeSequence = 0;
+// Record being written by the EEPROM ready interrupt, one byte per interrupt
+StoreRecord storeRecord;
+const unsigned char* storeNext;
+unsigned int storeAddress;
+volatile unsigned char storeLeft = 0;
+
+// CRC-8 of a record, starting from 0xFF so neither a blank (all 0xFF) nor a cleared (all 0x00) slot passes
+unsigned char StoreCrc(const StoreRecord* record)
+{
+    const unsigned char* data = (const unsigned char*)record;
+    unsigned char crc = 0xFF;
+    unsigned char i;
+    for (i = 0; i < offsetof(StoreRecord, crc); i++)
+    {
+        crc = _crc8_ccitt_update(crc, data[i]);
+    }
+    return crc;
+}
+
+// Read the newest record with a good CRC, false when there is none (blank EEPROM)
+// A save cut short by a power loss fails the CRC, the record before it is loaded instead
+bool StoreLoad(StoreRecord* record)
+{
+    StoreRecord slot;
+    unsigned char i;
+    bool found = false;
+
+    for (i = 0; i < STORE_SLOTS; i++)
+    {
+        eeprom_read_block(&slot, (const void*)(i * sizeof(StoreRecord)), sizeof(StoreRecord));
+        // The ring holds fewer records than half the sequence range, so the difference tells which is newer
+        if ((slot.crc == StoreCrc(&slot)) && (!found || ((signed char)(slot.sequence - record->sequence) > 0)))
+        {
+            *record = slot;
+            storeSlot = i;
+            found = true;
+        }
+    }
+    if (found)
+    {
+        storeSequence = record->sequence;
+    }
+    return found;
+}
+
+// EEPROM ready: start writing the next byte of the record, stop the interrupt once all of it went out
+ISR(EE_READY_vect)
+{
+    if (storeLeft == 0)
+    {
+        EECR &= ~(1 << EERIE);
+        return;
+    }
+    EEAR = storeAddress++;
+    EEDR = *storeNext++;
+    EECR |= (1 << EEMPE);
+    EECR |= (1 << EEPE);        // Within 4 cycles of EEMPE
+    storeLeft--;
+}
+
+// Write a record into the slot after the newest one, the interrupt sends it a byte every 3.4 ms
+// Returns false, and nothing is written, while the last record is still being written
+bool StoreWrite(const StoreRecord* record)
+{
+    if (StoreBusy())
+    {
+        return false;
+    }
+    storeRecord = *record;
+    storeRecord.sequence = ++storeSequence;
+    storeRecord.crc = StoreCrc(&storeRecord);
+    if (++storeSlot >= STORE_SLOTS)
+    {
+        storeSlot = 0;
+    }
+    storeAddress = storeSlot * sizeof(StoreRecord);
+    storeNext = (const unsigned char*)&storeRecord;
+    storeLeft = sizeof(StoreRecord);
+    EECR |= (1 << EERIE);       // Fires at once when the EEPROM is ready
+    return true;
+}
+
+// A record is still being written (the ready interrupt doesn't wake the CPU from power-down)
+bool StoreBusy()
+{
+    return (storeLeft != 0) || (EECR & (1 << EEPE));
+}
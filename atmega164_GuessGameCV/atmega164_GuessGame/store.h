@@ -0,0 +1,40 @@
+/*
+ * store.h
+ *
+ * Game state and statistics in EEPROM: a ring of CRC checked records written in the background.
+ */
+
+#ifndef STORE_H_
+#define STORE_H_
+
+#include <stdbool.h>
+#include <avr/io.h>
+
+// What the game saves, one record per save
+typedef struct
+{
+    unsigned char sequence;     // One more than the record before, the newest good record is loaded at boot
+    unsigned char page;         // Page open and its scroll
+    unsigned char scroll;
+    unsigned char menu;         // Menu selection
+    unsigned int word;          // Dictionary index of the last round, STORE_NO_WORD before the first one
+    unsigned long guessed;
+    unsigned char strikes;
+    unsigned char flags;
+    unsigned int wins;
+    unsigned int losses;
+    unsigned char crc;          // CRC-8 of the bytes before it
+} StoreRecord;
+
+#define STORE_NO_WORD 0xFFFF
+// flags: the last round ended, the next game starts with a new word
+#define STORE_NEW_WORD 0x01
+
+// Every save goes to the next slot so the writes are spread over the whole EEPROM
+#define STORE_SLOTS ((E2END + 1) / sizeof(StoreRecord))
+
+bool StoreLoad(StoreRecord* record);
+bool StoreWrite(const StoreRecord* record);
+bool StoreBusy();
+
+#endif /* STORE_H_ */
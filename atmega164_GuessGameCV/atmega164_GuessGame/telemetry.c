@@ -0,0 +1,129 @@
+/*
+ * telemetry.c
+ *
+ * Timer1 cycle counters for the BENCH_ sections, sent as binary frames over the UART.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "telemetry.h"
+#include "uart.h"
+
+#ifdef TELEMETRY
+
+// Timer1 counts every CPU cycle, the overflow interrupt extends it to 32 bits
+volatile unsigned int cycleHigh = 0;
+
+// Per section: when it was entered and the cycles spent in it since the last frame
+unsigned long profileStart[TELEMETRY_SECTIONS];
+unsigned long profileCycles[TELEMETRY_SECTIONS];
+
+// Bytes sent to the display since the last frame (counted by the flush)
+volatile unsigned int telemetryDisplayBytes = 0;
+unsigned char telemetrySequence = 0;
+unsigned char telemetryDropped = 0;
+
+ISR(TIMER1_OVF_vect)
+{
+    cycleHigh++;
+}
+
+// Cycles since TelemetryInit, an overflow still pending is counted in
+unsigned long CycleNow()
+{
+    unsigned int high;
+    unsigned int low;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        high = cycleHigh;
+        low = TCNT1;
+        if ((TIFR1 & (1 << TOV1)) && (low < 0x8000))
+        {
+            high++;
+        }
+    }
+    return ((unsigned long)high << 16) | low;
+}
+
+// Free running Timer1 at F_CPU and the UART
+void TelemetryInit()
+{
+    TCCR1A = 0;
+    TCCR1B = (1 << CS10);
+    TCNT1 = 0;
+    TIMSK1 = (1 << TOIE1);
+    UartInit();
+}
+
+// Section entered (ids start at 1 like the bench markers)
+void ProfileBegin(unsigned char id)
+{
+    profileStart[id - 1] = CycleNow();
+}
+
+// Section left, nested sections count inside their parent too
+void ProfileEnd(unsigned char id)
+{
+    profileCycles[id - 1] += CycleNow() - profileStart[id - 1];
+}
+
+// Queue an unsigned int little endian, returns the sum of its two bytes
+unsigned char TelemetryWord(unsigned int value)
+{
+    UartPut((unsigned char)value);
+    UartPut((unsigned char)(value >> 8));
+    return (unsigned char)value + (unsigned char)(value >> 8);
+}
+
+// Queue one frame with everything counted since the last one and start counting again
+// A frame that doesn't fit in the UART queue is dropped whole and counted, the main loop never waits
+void TelemetryFrame(unsigned int rendered, unsigned int skipped, unsigned int latency, unsigned int latencyMax, unsigned int overruns)
+{
+    unsigned char i;
+    unsigned char j;
+    unsigned char sum;
+    unsigned long cycles;
+    unsigned int bytes;
+
+    if (UartSpace() < TELEMETRY_FRAME)
+    {
+        if (telemetryDropped < 0xFF)
+        {
+            telemetryDropped++;
+        }
+        return;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        bytes = telemetryDisplayBytes;
+        telemetryDisplayBytes = 0;
+    }
+    UartPut(TELEMETRY_SYNC);
+    UartPut(TELEMETRY_PAYLOAD);
+    sum = telemetrySequence;
+    UartPut(telemetrySequence++);
+    for (i = 0; i < TELEMETRY_SECTIONS; i++)
+    {
+        cycles = profileCycles[i];
+        profileCycles[i] = 0;
+        for (j = 0; j < 4; j++, cycles >>= 8)
+        {
+            sum += (unsigned char)cycles;
+            UartPut((unsigned char)cycles);
+        }
+    }
+    sum += TelemetryWord(bytes);
+    sum += TelemetryWord(rendered);
+    sum += TelemetryWord(skipped);
+    sum += TelemetryWord(latency);
+    sum += TelemetryWord(latencyMax);
+    sum += TelemetryWord(overruns);
+    sum += telemetryDropped;
+    UartPut(telemetryDropped);
+    UartPut(sum);
+    telemetryDropped = 0;
+}
+
+#endif
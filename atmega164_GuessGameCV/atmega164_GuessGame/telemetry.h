@@ -0,0 +1,28 @@
+/*
+ * telemetry.h
+ *
+ * Timer1 cycle counters for the BENCH_ sections, sent as binary frames over the UART.
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+#include <stdbool.h>
+
+// Frame: TELEMETRY_SYNC, payload length, sequence number, then little endian
+// cycles of every section (BENCH_INPUT .. BENCH_FLUSH) as unsigned long, display bytes as unsigned int,
+// frames rendered and skipped so far as unsigned int, wake-to-render latency of the last press and the worst one in ms
+// and the presses over the limit as unsigned int, frames dropped before this one, and the 8 bit sum of the payload
+#define TELEMETRY_SYNC     0xA5
+#define TELEMETRY_SECTIONS 6
+#define TELEMETRY_PAYLOAD  (1 + TELEMETRY_SECTIONS * 4 + 2 + 2 + 2 + 2 + 2 + 2 + 1)
+#define TELEMETRY_FRAME    (2 + TELEMETRY_PAYLOAD + 1)
+
+extern volatile unsigned int telemetryDisplayBytes;
+
+void TelemetryInit();
+void ProfileBegin(unsigned char id);
+void ProfileEnd(unsigned char id);
+void TelemetryFrame(unsigned int rendered, unsigned int skipped, unsigned int latency, unsigned int latencyMax, unsigned int overruns);
+
+#endif /* TELEMETRY_H_ */
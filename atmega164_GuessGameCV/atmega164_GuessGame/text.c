@@ -0,0 +1,114 @@
+/*
+ * text.c
+ *
+ * Word wrapping for PROGMEM paragraphs: a line-start index built once per text.
+ */
+
+#include <stddef.h>
+#include <avr/pgmspace.h>
+
+#include "display.h"
+#include "text.h"
+
+// Index of the last text laid out, entry textLines is where the last line ends
+// There is room for one text only: opening help after about (or back) scans the paragraph again, a second index
+// would take another 50 bytes of the 1 KB of SRAM to save a pass that only runs when the page opens
+PGM_P textLaidOut = NULL;
+unsigned char textLines = 0;
+unsigned int textLineStart[TEXT_LINES_MAX + 1];
+// First line of the text in bank 0, TEXT_HIDDEN when the banks hold something else
+unsigned char textShownTop = TEXT_HIDDEN;
+
+// Wrap the text at spaces to the screen width in the proportional font ('\n' forces a break) and return the line count
+// Only the first call for a text scans it, later calls return the index already built until another text is laid out
+unsigned char TextLayout(PGM_P text)
+{
+    unsigned int start = 0;
+    unsigned int pos;
+    unsigned int space;
+    unsigned int width;
+    char letter;
+    if (text == textLaidOut)
+    {
+        return textLines;
+    }
+    textLines = 0;
+    while ((pgm_read_byte(text + start) != '\0') && (textLines < TEXT_LINES_MAX))
+    {
+        textLineStart[textLines++] = start;
+        space = start;
+        width = 0;
+        for (pos = start; (letter = pgm_read_byte(text + pos)) != '\0'; pos++)
+        {
+            if (letter == '\n')
+            {
+                pos++;
+                break;
+            }
+            if (letter == ' ')
+            {
+                space = pos;
+            }
+            // The blank column after the last character may fall off the screen
+            width += DisplayCharWidth(letter);
+            if (width > SCREEN_COLUMN + 1)
+            {
+                if (letter == ' ')
+                {
+                    pos++;              // Break on this space and drop it
+                }
+                else if (space > start)
+                {
+                    pos = space + 1;    // Move the cut word to the next line
+                }
+                break;                  // A word longer than a line is cut where it is
+            }
+        }
+        start = pos;
+    }
+    textLineStart[textLines] = start;
+    textLaidOut = text;
+    textShownTop = TEXT_HIDDEN;
+    return textLines;
+}
+
+// Print one line of the last text laid out, lines past the end print nothing
+void TextPrintLine(unsigned char row, unsigned char line)
+{
+    if (line < textLines)
+    {
+        DisplayPrintSpan_P(row, 0, textLaidOut + textLineStart[line], textLineStart[line + 1] - textLineStart[line]);
+    }
+}
+
+// Show the last text laid out from line top in banks 0..rows-1
+// A one line scroll moves the banks already drawn and prints only the line that comes into view
+void TextShow(unsigned char top, unsigned char rows)
+{
+    unsigned char row;
+    if ((textShownTop != TEXT_HIDDEN) && (top == textShownTop + 1))
+    {
+        DisplayScrollRows(0, rows - 1, true);
+        TextPrintLine(rows - 1, top + rows - 1);
+    }
+    else if ((textShownTop != TEXT_HIDDEN) && (top + 1 == textShownTop))
+    {
+        DisplayScrollRows(0, rows - 1, false);
+        TextPrintLine(0, top);
+    }
+    else if (top != textShownTop)
+    {
+        for (row = 0; row < rows; row++)
+        {
+            DisplayClearRow(row);
+            TextPrintLine(row, top + row);
+        }
+    }
+    textShownTop = top;
+}
+
+// The banks were drawn over, the next TextShow() redraws every line
+void TextHide()
+{
+    textShownTop = TEXT_HIDDEN;
+}
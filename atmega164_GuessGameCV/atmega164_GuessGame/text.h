@@ -0,0 +1,29 @@
+/*
+ * text.h
+ *
+ * Word wrapping for PROGMEM paragraphs: a line-start index built once per text.
+ */
+
+#ifndef TEXT_H_
+#define TEXT_H_
+
+#include <avr/pgmspace.h>
+
+#include "config.h"
+
+// Longest text that can be indexed, the rest is cut off
+#define TEXT_LINES_MAX 24
+// textShownTop when no text is on the screen
+#define TEXT_HIDDEN 0xFF
+
+extern PGM_P textLaidOut;
+extern unsigned char textLines;
+extern unsigned int textLineStart[TEXT_LINES_MAX + 1];
+extern unsigned char textShownTop;
+
+unsigned char TextLayout(PGM_P text);
+void TextPrintLine(unsigned char row, unsigned char line);
+void TextShow(unsigned char top, unsigned char rows);
+void TextHide();
+
+#endif /* TEXT_H_ */
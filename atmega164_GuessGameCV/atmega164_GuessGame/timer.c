@@ -0,0 +1,122 @@
+/*
+ * timer.c
+ *
+ * 1 ms system tick and cooperative task scheduler.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "input.h"
+#include "timer.h"
+
+volatile unsigned int tickCount = 0;
+Task tasks[TASK_MAX];
+
+// Timer0 Comp interrupt (1 ms)
+ISR(TIMER0_COMPA_vect)
+{
+    tickCount++;
+    if (buttonScan)
+    {
+        ButtonScan();
+    }
+}
+
+// Start the 1 ms tick (interrupts must be enabled with sei() afterwards)
+void TickInit()
+{
+    TCNT0 = 0x00;                           // Set timer to 0
+    OCR0A = TICK_OCR;                       // Compare match every 1 ms
+    TCCR0A = (1 << WGM01);                  // CTC mode, timer restarts at OCR0A by itself
+    TCCR0B = TICK_CS;                       // Prescaler picked for F_CPU by clock.h
+    TIMSK0 = (1 << OCIE0A);                 // Only the compare interrupt has a handler
+}
+
+// Milliseconds counted by Timer0 since TickInit (wraps after 65 s, compare with subtraction)
+// Timer0 stops in power-down, so this is awake (and idle) time, not wall clock time: it stands still while the
+// CPU sleeps waiting for a button and only measures intervals that stay awake, like a debounce or the wake latency
+unsigned int TickNow()
+{
+    unsigned int now;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        now = tickCount;
+    }
+    return now;
+}
+
+// Add a task that first runs after delay ms, returns its slot or TASK_MAX when the table is full
+unsigned char TaskAdd(TaskFunc func, unsigned int period, unsigned int delay)
+{
+    unsigned char i;
+    for (i = 0; i < TASK_MAX; i++)
+    {
+        if (tasks[i].func == NULL)
+        {
+            tasks[i].period = period;
+            tasks[i].due = TickNow() + delay;
+            tasks[i].func = func;
+            break;
+        }
+    }
+    return i;
+}
+
+// Remove a task or stop a one-shot timer before it fires
+void TaskCancel(unsigned char slot)
+{
+    if (slot < TASK_MAX)
+    {
+        tasks[slot].func = NULL;
+    }
+}
+
+// Start a one-shot timer calling func after ms milliseconds
+unsigned char TimerStart(unsigned int ms, TaskFunc func)
+{
+    return TaskAdd(func, 0, ms);
+}
+
+// Run every task that is due, tasks must return quickly because nothing preempts them
+void SchedulerRun()
+{
+    unsigned char i;
+    unsigned int now = TickNow();
+    for (i = 0; i < TASK_MAX; i++)
+    {
+        TaskFunc func = tasks[i].func;
+        if ((func != NULL) && ((int)(now - tasks[i].due) >= 0))
+        {
+            if (tasks[i].period == 0)
+            {
+                tasks[i].func = NULL;
+            }
+            else
+            {
+                tasks[i].due += tasks[i].period;
+                if ((int)(now - tasks[i].due) >= 0)
+                {
+                    tasks[i].due = now + tasks[i].period;     // Fell behind, skip the missed runs
+                }
+            }
+            func();
+        }
+    }
+}
+
+// Some task or timer is waiting for the tick, so the CPU may only sleep in a mode that keeps Timer0 running
+bool SchedulerPending()
+{
+    unsigned char i;
+    for (i = 0; i < TASK_MAX; i++)
+    {
+        if (tasks[i].func != NULL)
+        {
+            return true;
+        }
+    }
+    return false;
+}
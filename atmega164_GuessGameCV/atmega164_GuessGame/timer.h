@@ -0,0 +1,36 @@
+/*
+ * timer.h
+ *
+ * 1 ms system tick and cooperative task scheduler.
+ */
+
+#ifndef TIMER_H_
+#define TIMER_H_
+
+#include <stdbool.h>
+
+#include "clock.h"
+
+#define TASK_MAX 6
+
+typedef void (*TaskFunc)(void);
+
+// A task runs every period ms, a period of 0 makes it a one-shot timer that is removed after it runs
+typedef struct
+{
+    TaskFunc func;
+    unsigned int period;
+    unsigned int due;
+} Task;
+
+extern volatile unsigned int tickCount;
+
+void TickInit();
+unsigned int TickNow();
+unsigned char TaskAdd(TaskFunc func, unsigned int period, unsigned int delay);
+void TaskCancel(unsigned char slot);
+unsigned char TimerStart(unsigned int ms, TaskFunc func);
+void SchedulerRun();
+bool SchedulerPending();
+
+#endif /* TIMER_H_ */
@@ -0,0 +1,88 @@
+/*
+ * uart.c
+ *
+ * USART0 transmitter with an interrupt-driven ring buffer, writers never wait.
+ */
+
+#include <stdbool.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "uart.h"
+
+// Bytes waiting for the transmitter, filled by the main loop and emptied by the UDRE interrupt
+unsigned char uartQueue[UART_TX_SIZE];
+volatile unsigned char uartHead = 0;
+volatile unsigned char uartTail = 0;
+
+// Data register empty: hand the next byte to the USART, stop the interrupt when the queue ran dry
+ISR(USART0_UDRE_vect)
+{
+    unsigned char tail = uartTail;
+    if (tail == uartHead)
+    {
+        UCSR0B &= ~(1 << UDRIE0);
+        return;
+    }
+    UDR0 = uartQueue[tail];
+    uartTail = (tail + 1) & (UART_TX_SIZE - 1);
+}
+
+// Transmit complete: the last byte left the shift register, with nothing queued the transmitter is switched
+// off and TXD0 (PD1) is the pulled-up right button again. The pin changes the frame made are dropped before
+// PCINT25 is unmasked, so they neither wake the CPU nor start a key scan
+ISR(USART0_TX_vect)
+{
+    if (uartTail == uartHead)
+    {
+        UCSR0B &= ~((1 << TXEN0) | (1 << TXCIE0));
+        PCIFR = (1 << PCIF3);
+        PCMSK3 |= (1 << PCINT25);
+    }
+}
+
+// 8N1 transmitter only at BAUDRATE (double speed, UBRRVAL from clock.h), left off until there is something to send
+void UartInit()
+{
+    UBRR0 = UBRRVAL;
+    UCSR0A = (1 << U2X0);
+    UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
+    UCSR0B = 0;
+    uartHead = 0;
+    uartTail = 0;
+}
+
+// Queue a byte, false (and the byte is dropped) when the queue is full
+bool UartPut(unsigned char data)
+{
+    unsigned char head = uartHead;
+    unsigned char next = (head + 1) & (UART_TX_SIZE - 1);
+    if (next == uartTail)
+    {
+        return false;
+    }
+    uartQueue[head] = data;
+    uartHead = next;
+    UCSR0A = (1 << U2X0) | (1 << TXC0);     // Writing 1 clears TXC0, it is set again once the line goes idle
+    // The transmitter takes PD1 over until the queue drains, its edges must not look like the right button
+    // (atomic so the transmit complete interrupt can't unmask PCINT25 between the two writes)
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        PCMSK3 &= ~(1 << PCINT25);
+        UCSR0B |= (1 << TXEN0) | (1 << UDRIE0) | (1 << TXCIE0);
+    }
+    return true;
+}
+
+// Free bytes in the queue, a writer checks this first to never send half a message
+unsigned char UartSpace()
+{
+    return (uartTail - uartHead - 1) & (UART_TX_SIZE - 1);
+}
+
+// Bytes still queued or shifting out (the USART clock stops in power-down), the transmitter is on exactly as long
+bool UartBusy()
+{
+    return (UCSR0B & (1 << TXEN0)) != 0;
+}
@@ -0,0 +1,21 @@
+/*
+ * uart.h
+ *
+ * USART0 transmitter with an interrupt-driven ring buffer, writers never wait.
+ */
+
+#ifndef UART_H_
+#define UART_H_
+
+#include <stdbool.h>
+
+#include "clock.h"
+
+#define UART_TX_SIZE 64     // Power of 2, one slot stays empty to tell full from empty
+
+void UartInit();
+bool UartPut(unsigned char data);
+unsigned char UartSpace();
+bool UartBusy();
+
+#endif /* UART_H_ */
@@ -0,0 +1,359 @@
+/*
+ * bench.c
+ *
+ * Runs the firmware ELF (built with -DBENCH) under simavr, plays a button
+ * script and reports the cycles and SPI bytes of every section marked with
+ * BENCH_BEGIN/BENCH_END in the firmware (see bench.h), optionally compared
+ * against a stored baseline. Display bytes are counted from the SPI
+ * peripheral and, for the software SPI fallback, from the SCK pin.
+ *
+ * Script characters are the same as for the host build:
+ *   u d l r   press and release up, down, left or right
+ *   .         wait 100 ms
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sim_avr.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+#include "avr_ioport.h"
+#include "avr_spi.h"
+
+#include "bench.h"
+
+#define GPIOR0_ADDRESS 0x3E     // Data space address of GPIOR0 on the ATmega164
+#define SPCR_ADDRESS   0x4C     // Data space address of SPCR
+#define SPE_BIT        6
+#define SCK_PIN        7        // PB7
+#define SECTION_COUNT  (BENCH_SPI_ISR + 1)
+
+#define KEY_HOLD_MS 50
+#define KEY_GAP_MS  150
+#define BOOT_MS     100
+
+typedef struct
+{
+    const char *name;
+    unsigned long calls;
+    unsigned long long cycles;
+    unsigned long long byteCycles;      // Cycles of the calls that sent SPI bytes
+    unsigned long spiBytes;
+    bool open;
+    avr_cycle_count_t start;
+    unsigned long spiStart;
+} Section;
+
+static Section sections[SECTION_COUNT] =
+{
+    [BENCH_INPUT]      = { "input" },
+    [BENCH_RENDER]     = { "render" },
+    [BENCH_GAME]       = { "game" },
+    [BENCH_CLEAR]      = { "clear" },
+    [BENCH_PRINT_LINE] = { "print_line" },
+    [BENCH_FLUSH]      = { "flush" },
+    [BENCH_SPI_ISR]    = { "spi_isr" },
+};
+
+// Result of Compare, also the exit status of the run (2 is a usage error)
+typedef enum
+{
+    COMPARE_OK = 0,
+    COMPARE_SLOWER = 1,
+    COMPARE_NO_BASELINE = 3,
+} CompareResult;
+
+static unsigned long spiBytes = 0;
+static unsigned char sckEdges = 0;
+static bool sckHigh = false;
+static unsigned long cyclesPerMs;
+
+// GPIOR0 write: BENCH_BEGIN/BENCH_END of a section
+static void MarkerWrite(struct avr_t *avr, avr_io_addr_t addr, uint8_t value, void *param)
+{
+    unsigned char id = value & ~BENCH_END_FLAG;
+    Section *section;
+
+    (void)param;
+    avr->data[addr] = value;
+    if ((id >= SECTION_COUNT) || (sections[id].name == NULL))
+    {
+        return;
+    }
+    section = &sections[id];
+    if (value & BENCH_END_FLAG)
+    {
+        if (section->open)
+        {
+            section->calls++;
+            section->cycles += avr->cycle - section->start;
+            if (spiBytes != section->spiStart)
+            {
+                section->byteCycles += avr->cycle - section->start;
+            }
+            section->spiBytes += spiBytes - section->spiStart;
+            section->open = false;
+        }
+    }
+    else
+    {
+        section->open = true;
+        section->start = avr->cycle;
+        section->spiStart = spiBytes;
+    }
+}
+
+// Every byte the SPI peripheral shifts out
+static void SpiOutput(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    (void)irq;
+    (void)value;
+    (void)param;
+    spiBytes++;
+}
+
+// SCK output changes: with the SPI peripheral off every 8th rising edge ends a byte of the software SPI fallback
+static void SckOutput(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    avr_t *avr = param;
+
+    (void)irq;
+    if ((value != 0) && !sckHigh && ((avr->data[SPCR_ADDRESS] & (1 << SPE_BIT)) == 0) && (++sckEdges == 8))
+    {
+        sckEdges = 0;
+        spiBytes++;
+    }
+    sckHigh = (value != 0);
+}
+
+static void RunMs(avr_t *avr, unsigned int ms)
+{
+    avr_cycle_count_t end = avr->cycle + (avr_cycle_count_t)ms * cyclesPerMs;
+    while (avr->cycle < end)
+    {
+        int state = avr_run(avr);
+        if ((state == cpu_Done) || (state == cpu_Crashed))
+        {
+            fprintf(stderr, "firmware stopped (state %d) at cycle %llu\n", state, (unsigned long long)avr->cycle);
+            exit(1);
+        }
+    }
+}
+
+static void Press(avr_t *avr, int pin)
+{
+    avr_irq_t *irq = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), pin);
+    avr_raise_irq(irq, 0);
+    RunMs(avr, KEY_HOLD_MS);
+    avr_raise_irq(irq, 1);
+    RunMs(avr, KEY_GAP_MS);
+}
+
+// One line per section that ran, perByte adds the cycles per SPI byte (the baseline file leaves it out), taken over
+// the calls that sent something so the flushes that found nothing to send don't hide the transport cost
+static void Report(FILE *out, bool perByte)
+{
+    int id;
+    for (id = 0; id < SECTION_COUNT; id++)
+    {
+        const Section *section = &sections[id];
+        if ((section->name != NULL) && (section->calls > 0))
+        {
+            fprintf(out, "%-10s %6lu %10llu %6lu", section->name, section->calls,
+                    section->cycles / section->calls, section->spiBytes / section->calls);
+            if (perByte && (section->spiBytes > 0))
+            {
+                fprintf(out, " %8.1f", (double)section->byteCycles / (double)section->spiBytes);
+            }
+            fprintf(out, "\n");
+        }
+    }
+}
+
+// Compare per-call cycles against a file written by -w (lines starting with # are comments), COMPARE_SLOWER when
+// a section got slower than the limit and COMPARE_NO_BASELINE when there is nothing to compare with: a run without
+// a baseline proves nothing, but it is not a regression either
+static CompareResult Compare(const char *path, double limit)
+{
+    char line[128];
+    char name[32];
+    unsigned long calls;
+    unsigned long long cycles;
+    unsigned long bytes;
+    CompareResult result = COMPARE_OK;
+    int compared = 0;
+    int id;
+    FILE *file = fopen(path, "r");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "no baseline found at %s; run `make baseline`\n", path);
+        return COMPARE_NO_BASELINE;
+    }
+    printf("\n%-10s %12s %12s %8s %10s\n", "section", "base cyc", "now cyc", "delta", "spi delta");
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if ((line[0] == '#') || (sscanf(line, "%31s %lu %llu %lu", name, &calls, &cycles, &bytes) != 4))
+        {
+            continue;
+        }
+        for (id = 0; id < SECTION_COUNT; id++)
+        {
+            const Section *section = &sections[id];
+            if ((section->name != NULL) && (strcmp(section->name, name) == 0) && (section->calls > 0) && (cycles > 0))
+            {
+                unsigned long long now = section->cycles / section->calls;
+                double delta = 100.0 * ((double)now - (double)cycles) / (double)cycles;
+                long spi = (long)(section->spiBytes / section->calls) - (long)bytes;
+                printf("%-10s %12llu %12llu %+7.1f%% %+10ld\n", name, cycles, now, delta, spi);
+                compared++;
+                if (delta > limit)
+                {
+                    result = COMPARE_SLOWER;
+                }
+            }
+        }
+    }
+    fclose(file);
+    if (compared == 0)
+    {
+        fprintf(stderr, "baseline %s has no section of this run; run `make baseline`\n", path);
+        return COMPARE_NO_BASELINE;
+    }
+    return result;
+}
+
+static void Usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-m mcu] [-f hz] [-s script] [-b baseline] [-w baseline] [-t percent] firmware.elf\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    const char *mcu = "atmega164p";
+    const char *script = "";
+    const char *key;
+    const char *baseline = NULL;
+    const char *output = NULL;
+    unsigned long frequency = 1000000;
+    double limit = 5.0;
+    elf_firmware_t firmware;
+    avr_t *avr;
+    int option;
+
+    while ((option = getopt(argc, argv, "m:f:s:b:w:t:")) != -1)
+    {
+        switch (option)
+        {
+        case 'm':
+            mcu = optarg;
+            break;
+        case 'f':
+            frequency = strtoul(optarg, NULL, 0);
+            break;
+        case 's':
+            script = optarg;
+            break;
+        case 'b':
+            baseline = optarg;
+            break;
+        case 'w':
+            output = optarg;
+            break;
+        case 't':
+            limit = atof(optarg);
+            break;
+        default:
+            Usage(argv[0]);
+        }
+    }
+    if (optind + 1 != argc)
+    {
+        Usage(argv[0]);
+    }
+
+    memset(&firmware, 0, sizeof(firmware));
+    if (elf_read_firmware(argv[optind], &firmware) != 0)
+    {
+        fprintf(stderr, "can't read %s\n", argv[optind]);
+        return 1;
+    }
+    avr = avr_make_mcu_by_name(firmware.mmcu[0] ? firmware.mmcu : mcu);
+    if (avr == NULL)
+    {
+        fprintf(stderr, "simavr does not know %s\n", firmware.mmcu[0] ? firmware.mmcu : mcu);
+        return 1;
+    }
+    avr_init(avr);
+    avr_load_firmware(avr, &firmware);
+    avr->frequency = firmware.frequency ? firmware.frequency : frequency;
+    cyclesPerMs = avr->frequency / 1000;
+
+    avr_register_io_write(avr, GPIOR0_ADDRESS, MarkerWrite, NULL);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_SPI_GETIRQ(0), SPI_IRQ_OUTPUT), SpiOutput, NULL);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('B'), SCK_PIN), SckOutput, avr);
+    for (option = 0; option < 4; option++)
+    {
+        avr_raise_irq(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), option), 1);     // Released
+    }
+
+    RunMs(avr, BOOT_MS);
+    for (key = script; *key != '\0'; key++)
+    {
+        switch (*key)
+        {
+        case 'u':
+            Press(avr, 0);
+            break;
+        case 'r':
+            Press(avr, 1);
+            break;
+        case 'l':
+            Press(avr, 2);
+            break;
+        case 'd':
+            Press(avr, 3);
+            break;
+        case '.':
+            RunMs(avr, 100);
+            break;
+        case ' ':
+        case '\t':
+        case '\n':
+            break;
+        default:
+            fprintf(stderr, "unknown script character '%c'\n", *key);
+            return 2;
+        }
+    }
+
+    printf("%-10s %6s %10s %6s %8s\n", "section", "calls", "cyc/call", "spi/call", "cyc/byte");
+    Report(stdout, true);
+    if (output != NULL)
+    {
+        FILE *file = fopen(output, "w");
+        if (file == NULL)
+        {
+            fprintf(stderr, "can't write %s\n", output);
+            return 1;
+        }
+        fprintf(file, "# %s at %lu Hz, script \"%s\"\n", argv[optind], (unsigned long)avr->frequency, script);
+        Report(file, false);
+        fclose(file);
+    }
+    if (baseline != NULL)
+    {
+        CompareResult result = Compare(baseline, limit);
+        if (result == COMPARE_SLOWER)
+        {
+            fprintf(stderr, "\nslower than %s by more than %.1f%%\n", baseline, limit);
+        }
+        return result;
+    }
+    return 0;
+}
@@ -0,0 +1,17 @@
+/*
+ * host.h
+ *
+ * Shared state of the host build: the emulated display behind the SPI
+ * transport and the interrupt-driven transfer in flight.
+ */
+
+#ifndef HOST_H_
+#define HOST_H_
+
+#include "pcd8544.h"
+
+extern Pcd8544 hostLcd;
+// A byte was started with spiPut() and its SPI complete interrupt has not run yet
+extern int hostSpiPending;
+
+#endif /* HOST_H_ */
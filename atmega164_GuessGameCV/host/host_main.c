@@ -0,0 +1,229 @@
+/*
+ * host_main.c
+ *
+ * Runs the firmware on a PC: a scripted button sequence drives the mock
+ * PIND, the 1 ms tick, pin-change and SPI interrupts are called by hand, and
+ * after every step the bytes sent to the emulated PCD8544 (and the CPU
+ * cycles of the interrupt flush, when it is used) are reported and the
+ * screen can be dumped as PBM.
+ *
+ * Script characters:
+ *   u d l r   press and release up, down, left or right
+ *   .         wait 100 ms
+ * Whitespace is ignored.
+ *
+ * With -e the EEPROM is loaded from a file (blank when it doesn't exist
+ * yet) and written back after the script, so a second run resumes from
+ * what the first one saved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <avr/eeprom.h>
+
+#include "app.h"
+#include "config.h"
+#include "input.h"
+#include "host.h"
+#include "spi.h"
+
+#define KEY_HOLD_MS 50      // How long a scripted press holds the key down
+#define KEY_GAP_MS  150     // Time after the release before the next step
+#define BOOT_MS     100
+#define SAVE_MS     3000    // Lets a deferred save finish before the EEPROM image is written
+#define EEPROM_WRITE_MS 4   // One EEPROM byte takes 3.4 ms
+// Bytes the interrupt flush gets out per ms: 8 SPI clocks each, then the interrupt that starts the next one
+#define SPI_BYTES_PER_MS (F_CPU / 1000 / (8 * SPI_DIVIDER + DISPLAY_ISR_CYCLES))
+
+void TIMER0_COMPA_vect(void);
+void PCINT3_vect(void);
+void SPI_STC_vect(void);
+void USART0_UDRE_vect(void);
+void USART0_TX_vect(void);
+void EE_READY_vect(void);
+
+// Buttons held by the script as a PIND mask
+static unsigned char keysHeld = 0;
+// Time the EEPROM byte write in progress has taken
+static unsigned int eepromWriteMs = 0;
+// CPU cycles the SPI complete interrupts took away from the main loop
+static unsigned long isrCycles = 0;
+
+// Advance the firmware by ms milliseconds, one tick and main loop pass per ms
+static void RunMs(unsigned int ms)
+{
+    while (ms-- > 0)
+    {
+        unsigned char pins = (unsigned char)(~keysHeld & BUTTON_MASK);
+        unsigned char changed = (PIND ^ pins) & BUTTON_MASK;
+        PIND = (PIND & ~BUTTON_MASK) | pins;
+        if ((changed & PCMSK3) && (PCICR & (1 << PCIE3)))
+        {
+            PCINT3_vect();
+        }
+        TIMER0_COMPA_vect();
+        AppRun();
+#if DISPLAY_ISR_FLUSH
+        // Background display flush: the transfers finished during this ms raise the SPI interrupt, each one
+        // costs the CPU DISPLAY_ISR_CYCLES
+        for (unsigned int sent = 0; hostSpiPending && (SPCR & (1 << SPIE)) && (sent < SPI_BYTES_PER_MS); sent++)
+        {
+            hostSpiPending = 0;
+            SPI_STC_vect();
+            isrCycles += DISPLAY_ISR_CYCLES;
+        }
+#endif
+        // EEPROM: the byte started with EEPE lands after EEPROM_WRITE_MS, then the ready interrupt asks for the next
+        if (EECR & (1 << EEPE))
+        {
+            if (++eepromWriteMs >= EEPROM_WRITE_MS)
+            {
+                mockEeprom[EEAR] = EEDR;
+                EECR &= ~((1 << EEPE) | (1 << EEMPE));
+                eepromWriteMs = 0;
+            }
+        }
+        else if (EECR & (1 << EERIE))
+        {
+            EE_READY_vect();
+        }
+#ifdef TELEMETRY
+        // USART0 at 9600 baud moves about a byte per ms, TXC0 comes up once the queue ran dry and its interrupt
+        // (which clears the flag) switches the transmitter off
+        if (UCSR0B & (1 << UDRIE0))
+        {
+            UCSR0A &= ~(1 << TXC0);
+            USART0_UDRE_vect();
+        }
+        else if (UCSR0B & (1 << TXEN0))
+        {
+            UCSR0A |= (1 << TXC0);
+            if (UCSR0B & (1 << TXCIE0))
+            {
+                UCSR0A &= ~(1 << TXC0);
+                USART0_TX_vect();
+            }
+        }
+#endif
+    }
+}
+
+static void Report(const char *prefix, unsigned int step, char key, unsigned long data, unsigned long commands, unsigned long isr)
+{
+    printf("%3u %c data %4lu cmd %3lu total %4lu isr %6lu\n", step, key, data, commands, data + commands, isr);
+    if (prefix != NULL)
+    {
+        char path[512];
+        snprintf(path, sizeof(path), "%s%03u.pbm", prefix, step);
+        if (!Pcd8544SavePbm(&hostLcd, path))
+        {
+            fprintf(stderr, "can't write %s\n", path);
+            exit(1);
+        }
+    }
+}
+
+static void Usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-s script] [-o pbm-prefix] [-e eeprom-file]\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    const char *script = "";
+    const char *prefix = NULL;
+    const char *eeprom = NULL;
+    FILE *file;
+    unsigned int step = 0;
+    unsigned long data;
+    unsigned long commands;
+    unsigned long isr;
+    int option;
+
+    while ((option = getopt(argc, argv, "s:o:e:")) != -1)
+    {
+        switch (option)
+        {
+        case 's':
+            script = optarg;
+            break;
+        case 'o':
+            prefix = optarg;
+            break;
+        case 'e':
+            eeprom = optarg;
+            break;
+        default:
+            Usage(argv[0]);
+        }
+    }
+
+    memset(mockEeprom, 0xFF, sizeof(mockEeprom));
+    if ((eeprom != NULL) && ((file = fopen(eeprom, "rb")) != NULL))
+    {
+        if (fread(mockEeprom, 1, sizeof(mockEeprom), file) != sizeof(mockEeprom))
+        {
+            fprintf(stderr, "%s is not a %u byte EEPROM image\n", eeprom, (unsigned int)sizeof(mockEeprom));
+            return 1;
+        }
+        fclose(file);
+    }
+    Pcd8544Reset(&hostLcd);
+    PIND = BUTTON_MASK;     // Pull-ups, nothing pressed
+    AppInit();
+    RunMs(BOOT_MS);
+    Report(prefix, step++, '*', hostLcd.dataBytes, hostLcd.commandBytes, isrCycles);
+
+    for (; *script != '\0'; script++)
+    {
+        unsigned char key;
+        switch (*script)
+        {
+        case 'u':
+            key = P_UP;
+            break;
+        case 'd':
+            key = P_DWN;
+            break;
+        case 'l':
+            key = P_LFT;
+            break;
+        case 'r':
+            key = P_RGT;
+            break;
+        case '.':
+            RunMs(100);
+            continue;
+        case ' ':
+        case '\t':
+        case '\n':
+            continue;
+        default:
+            fprintf(stderr, "unknown script character '%c'\n", *script);
+            return 2;
+        }
+        data = hostLcd.dataBytes;
+        commands = hostLcd.commandBytes;
+        isr = isrCycles;
+        keysHeld |= (1 << key);
+        RunMs(KEY_HOLD_MS);
+        keysHeld &= ~(1 << key);
+        RunMs(KEY_GAP_MS);
+        Report(prefix, step++, *script, hostLcd.dataBytes - data, hostLcd.commandBytes - commands, isrCycles - isr);
+    }
+    if (eeprom != NULL)
+    {
+        RunMs(SAVE_MS);
+        if (((file = fopen(eeprom, "wb")) == NULL) || (fwrite(mockEeprom, 1, sizeof(mockEeprom), file) != sizeof(mockEeprom)))
+        {
+            fprintf(stderr, "can't write %s\n", eeprom);
+            return 1;
+        }
+        fclose(file);
+    }
+    return 0;
+}
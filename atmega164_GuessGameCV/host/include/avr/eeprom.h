@@ -0,0 +1,28 @@
+/*
+ * avr/eeprom.h (host build)
+ *
+ * The EEPROM is the array mockEeprom in mock_io.c. Reads go straight to
+ * it, writes through EEAR/EEDR/EEPE are carried out by the harness.
+ */
+
+#ifndef MOCK_AVR_EEPROM_H_
+#define MOCK_AVR_EEPROM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <avr/io.h>
+
+extern uint8_t mockEeprom[E2END + 1];
+
+static inline uint8_t eeprom_read_byte(const uint8_t *address)
+{
+    return mockEeprom[(uintptr_t)address];
+}
+
+static inline void eeprom_read_block(void *destination, const void *source, size_t length)
+{
+    memcpy(destination, &mockEeprom[(uintptr_t)source], length);
+}
+
+#endif /* MOCK_AVR_EEPROM_H_ */
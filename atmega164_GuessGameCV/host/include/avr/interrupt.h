@@ -0,0 +1,16 @@
+/*
+ * avr/interrupt.h (host build)
+ *
+ * Interrupt handlers become plain functions named after their vector so
+ * the harness can call them, e.g. TIMER0_COMPA_vect() for one tick.
+ */
+
+#ifndef MOCK_AVR_INTERRUPT_H_
+#define MOCK_AVR_INTERRUPT_H_
+
+#define ISR(vector) void vector(void); void vector(void)
+
+#define sei() ((void)0)
+#define cli() ((void)0)
+
+#endif /* MOCK_AVR_INTERRUPT_H_ */
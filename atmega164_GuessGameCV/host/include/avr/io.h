@@ -0,0 +1,187 @@
+/*
+ * avr/io.h (host build)
+ *
+ * Mock ATmega164A registers for building the firmware on a PC. Every
+ * register is a plain variable defined in mock_io.c, the harness drives
+ * the inputs (PIND) and reads the outputs (PORTB) directly.
+ */
+
+#ifndef MOCK_AVR_IO_H_
+#define MOCK_AVR_IO_H_
+
+#include <stdint.h>
+
+#define MOCK_REGISTERS(X) \
+    X(PINA) X(DDRA) X(PORTA) X(PINB) X(DDRB) X(PORTB) \
+    X(PINC) X(DDRC) X(PORTC) X(PIND) X(DDRD) X(PORTD) \
+    X(SPCR) X(SPSR) X(SPDR) \
+    X(TCCR0A) X(TCCR0B) X(TCNT0) X(OCR0A) X(OCR0B) X(TIMSK0) X(TIFR0) \
+    X(TCCR1A) X(TCCR1B) X(TCCR1C) X(TIMSK1) X(TIFR1) \
+    X(TCCR2A) X(TCCR2B) X(TCNT2) X(OCR2A) X(OCR2B) X(TIMSK2) X(TIFR2) X(ASSR) \
+    X(PCICR) X(PCIFR) X(PCMSK0) X(PCMSK1) X(PCMSK2) X(PCMSK3) \
+    X(UCSR0A) X(UCSR0B) X(UCSR0C) X(UBRR0H) X(UBRR0L) X(UDR0) \
+    X(ADMUX) X(ADCSRA) X(ADCSRB) X(ADCL) X(ADCH) X(DIDR0) \
+    X(WDTCSR) X(MCUSR) X(SMCR) X(PRR0) X(SREG) X(ACSR) \
+    X(EECR) X(EEDR) X(GPIOR0) X(GPIOR1) X(GPIOR2)
+
+#define MOCK_REGISTERS16(X) \
+    X(TCNT1) X(OCR1A) X(OCR1B) X(ICR1) X(UBRR0) X(ADC) X(EEAR)
+
+#define MOCK_DECLARE(name) extern volatile uint8_t name;
+#define MOCK_DECLARE16(name) extern volatile uint16_t name;
+MOCK_REGISTERS(MOCK_DECLARE)
+MOCK_REGISTERS16(MOCK_DECLARE16)
+#undef MOCK_DECLARE
+#undef MOCK_DECLARE16
+
+#define RAMSTART 0x0100
+#define RAMEND 0x04FF
+#define E2END  0x01FF
+
+// Port bits
+#define PINB0 0
+#define PINB1 1
+#define PINB2 2
+#define PINB3 3
+#define PINB4 4
+#define PINB5 5
+#define PINB6 6
+#define PINB7 7
+#define PIND0 0
+#define PIND1 1
+#define PIND2 2
+#define PIND3 3
+#define PIND4 4
+#define PIND5 5
+#define PIND6 6
+#define PIND7 7
+
+// SPI
+#define SPIE  7
+#define SPE   6
+#define DORD  5
+#define MSTR  4
+#define CPOL  3
+#define CPHA  2
+#define SPR1  1
+#define SPR0  0
+#define SPIF  7
+#define WCOL  6
+#define SPI2X 0
+
+// Timer0
+#define WGM00  0
+#define WGM01  1
+#define WGM02  3
+#define CS00   0
+#define CS01   1
+#define CS02   2
+#define OCIE0B 2
+#define OCIE0A 1
+#define TOIE0  0
+#define OCF0B  2
+#define OCF0A  1
+#define TOV0   0
+
+// Timer1
+#define WGM10  0
+#define WGM11  1
+#define WGM12  3
+#define WGM13  4
+#define CS10   0
+#define CS11   1
+#define CS12   2
+#define OCIE1A 1
+#define TOIE1  0
+#define TOV1   0
+
+// Timer2
+#define WGM20  0
+#define WGM21  1
+#define CS20   0
+#define CS21   1
+#define CS22   2
+#define OCIE2A 1
+#define TOIE2  0
+#define AS2    5
+
+// Pin change interrupts
+#define PCIE0   0
+#define PCIE1   1
+#define PCIE2   2
+#define PCIE3   3
+#define PCIF3   3
+#define PCINT24 0
+#define PCINT25 1
+#define PCINT26 2
+#define PCINT27 3
+
+// USART0
+#define RXC0   7
+#define TXC0   6
+#define UDRE0  5
+#define U2X0   1
+#define RXCIE0 7
+#define TXCIE0 6
+#define UDRIE0 5
+#define RXEN0  4
+#define TXEN0  3
+#define UCSZ01 2
+#define UCSZ00 1
+
+// ADC
+#define REFS1 7
+#define REFS0 6
+#define ADLAR 5
+#define MUX4  4
+#define MUX3  3
+#define MUX2  2
+#define MUX1  1
+#define MUX0  0
+#define ADEN  7
+#define ADSC  6
+#define ADATE 5
+#define ADIF  4
+#define ADIE  3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+
+// Watchdog, reset flags and sleep
+#define WDIF 7
+#define WDIE 6
+#define WDP3 5
+#define WDCE 4
+#define WDE  3
+#define WDP2 2
+#define WDP1 1
+#define WDP0 0
+#define WDRF 3
+#define BORF 2
+#define EXTRF 1
+#define PORF 0
+#define SM2  3
+#define SM1  2
+#define SM0  1
+#define SE   0
+
+// Analog comparator
+#define ACD  7
+
+// Power reduction
+#define PRTWI    7
+#define PRTIM2   6
+#define PRTIM0   5
+#define PRUSART1 4
+#define PRTIM1   3
+#define PRSPI    2
+#define PRUSART0 1
+#define PRADC    0
+
+// EEPROM
+#define EERIE 3
+#define EEMPE 2
+#define EEPE  1
+#define EERE  0
+
+#endif /* MOCK_AVR_IO_H_ */
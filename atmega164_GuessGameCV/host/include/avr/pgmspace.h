@@ -0,0 +1,29 @@
+/*
+ * avr/pgmspace.h (host build)
+ *
+ * On a PC flash and RAM share one address space, so PROGMEM is empty and
+ * the pgm_read_ functions are plain reads.
+ */
+
+#ifndef MOCK_AVR_PGMSPACE_H_
+#define MOCK_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_byte_near(address) pgm_read_byte(address)
+#define pgm_read_word(address) ((uint16_t)*(address))
+#define pgm_read_word_near(address) pgm_read_word(address)
+#define pgm_read_dword(address) ((uint32_t)*(address))
+#define pgm_read_ptr(address) (*(address))
+
+#define strcpy_P strcpy
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+#endif /* MOCK_AVR_PGMSPACE_H_ */
@@ -0,0 +1,19 @@
+/*
+ * avr/sleep.h (host build)
+ */
+
+#ifndef MOCK_AVR_SLEEP_H_
+#define MOCK_AVR_SLEEP_H_
+
+#define SLEEP_MODE_IDLE      0
+#define SLEEP_MODE_ADC       (1 << SM0)
+#define SLEEP_MODE_PWR_DOWN  (1 << SM1)
+#define SLEEP_MODE_PWR_SAVE  ((1 << SM0) | (1 << SM1))
+#define SLEEP_MODE_STANDBY   ((1 << SM1) | (1 << SM2))
+
+#define set_sleep_mode(mode) (SMCR = (SMCR & ~((1 << SM0) | (1 << SM1) | (1 << SM2))) | (mode))
+#define sleep_enable() (SMCR |= (1 << SE))
+#define sleep_disable() (SMCR &= ~(1 << SE))
+#define sleep_cpu() ((void)0)
+
+#endif /* MOCK_AVR_SLEEP_H_ */
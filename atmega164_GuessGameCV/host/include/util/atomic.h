@@ -0,0 +1,15 @@
+/*
+ * util/atomic.h (host build)
+ *
+ * Interrupts are called by the harness between main loop passes, so an
+ * atomic block is just a block.
+ */
+
+#ifndef MOCK_UTIL_ATOMIC_H_
+#define MOCK_UTIL_ATOMIC_H_
+
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON 0
+#define ATOMIC_BLOCK(type) for (int atomicOnce = 1; atomicOnce; atomicOnce = 0)
+
+#endif /* MOCK_UTIL_ATOMIC_H_ */
@@ -0,0 +1,31 @@
+/*
+ * util/crc16.h (host build)
+ *
+ * The CRC helpers of avr-libc in plain C (the equivalents given in its
+ * documentation).
+ */
+
+#ifndef MOCK_UTIL_CRC16_H_
+#define MOCK_UTIL_CRC16_H_
+
+#include <stdint.h>
+
+static inline uint8_t _crc8_ccitt_update(uint8_t crc, uint8_t data)
+{
+    uint8_t i;
+    data ^= crc;
+    for (i = 0; i < 8; i++)
+    {
+        if (data & 0x80)
+        {
+            data = (data << 1) ^ 0x07;
+        }
+        else
+        {
+            data <<= 1;
+        }
+    }
+    return data;
+}
+
+#endif /* MOCK_UTIL_CRC16_H_ */
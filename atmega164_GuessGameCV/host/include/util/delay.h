@@ -0,0 +1,13 @@
+/*
+ * util/delay.h (host build)
+ *
+ * Busy-wait delays take no time on the host.
+ */
+
+#ifndef MOCK_UTIL_DELAY_H_
+#define MOCK_UTIL_DELAY_H_
+
+#define _delay_ms(ms) ((void)(ms))
+#define _delay_us(us) ((void)(us))
+
+#endif /* MOCK_UTIL_DELAY_H_ */
@@ -0,0 +1,16 @@
+/*
+ * mock_io.c
+ *
+ * Storage for the mock registers declared in include/avr/io.h.
+ */
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+
+#define MOCK_DEFINE(name) volatile uint8_t name;
+#define MOCK_DEFINE16(name) volatile uint16_t name;
+MOCK_REGISTERS(MOCK_DEFINE)
+MOCK_REGISTERS16(MOCK_DEFINE16)
+
+// EEPROM contents, blank (0xFF) unless the harness loads an image
+uint8_t mockEeprom[E2END + 1];
@@ -0,0 +1,155 @@
+/*
+ * pcd8544.c
+ *
+ * Software model of the PCD8544 controller (see pcd8544.h).
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pcd8544.h"
+
+// State after the RES pulse: everything zero, power down, display blank
+void Pcd8544Reset(Pcd8544 *lcd)
+{
+    memset(lcd, 0, sizeof(*lcd));
+    lcd->powerDown = true;
+}
+
+// Move the address pointer after a data byte the way the addressing mode does
+static void Pcd8544Advance(Pcd8544 *lcd)
+{
+    if (lcd->vertical)
+    {
+        if (++lcd->y == PCD8544_BANKS)
+        {
+            lcd->y = 0;
+            if (++lcd->x == PCD8544_WIDTH)
+            {
+                lcd->x = 0;
+            }
+        }
+    }
+    else
+    {
+        if (++lcd->x == PCD8544_WIDTH)
+        {
+            lcd->x = 0;
+            if (++lcd->y == PCD8544_BANKS)
+            {
+                lcd->y = 0;
+            }
+        }
+    }
+}
+
+static void Pcd8544Command(Pcd8544 *lcd, uint8_t cmd)
+{
+    if (cmd == 0x00)
+    {
+        return;     // NOP
+    }
+    if ((cmd & 0xF8) == 0x20)
+    {
+        lcd->powerDown = (cmd & 0x04) != 0;
+        lcd->vertical = (cmd & 0x02) != 0;
+        lcd->extended = (cmd & 0x01) != 0;
+    }
+    else if (!lcd->extended)
+    {
+        if ((cmd & 0xFA) == 0x08)
+        {
+            lcd->displayMode = ((cmd & 0x04) >> 1) | (cmd & 0x01);
+        }
+        else if (((cmd & 0xF8) == 0x40) && ((cmd & 0x07) < PCD8544_BANKS))
+        {
+            lcd->y = cmd & 0x07;
+        }
+        else if ((cmd & 0x80) && ((cmd & 0x7F) < PCD8544_WIDTH))
+        {
+            lcd->x = cmd & 0x7F;
+        }
+        else
+        {
+            lcd->unknownCommands++;
+        }
+    }
+    else
+    {
+        if ((cmd & 0xFC) == 0x04)
+        {
+            lcd->tempCoefficient = cmd & 0x03;
+        }
+        else if ((cmd & 0xF8) == 0x10)
+        {
+            lcd->bias = cmd & 0x07;
+        }
+        else if (cmd & 0x80)
+        {
+            lcd->vop = cmd & 0x7F;
+        }
+        else
+        {
+            lcd->unknownCommands++;
+        }
+    }
+}
+
+// One byte clocked in with D/C high (data) or low (command)
+void Pcd8544Write(Pcd8544 *lcd, bool data, uint8_t byte)
+{
+    if (data)
+    {
+        lcd->dataBytes++;
+        lcd->ram[lcd->y * PCD8544_WIDTH + lcd->x] = byte;
+        Pcd8544Advance(lcd);
+    }
+    else
+    {
+        lcd->commandBytes++;
+        Pcd8544Command(lcd, byte);
+    }
+}
+
+// Pixel as seen on the glass, taking display control and power down into account
+bool Pcd8544Pixel(const Pcd8544 *lcd, int x, int y)
+{
+    bool on = (lcd->ram[(y / 8) * PCD8544_WIDTH + x] >> (y % 8)) & 1;
+    if (lcd->powerDown)
+    {
+        return false;
+    }
+    switch (lcd->displayMode)
+    {
+    case 0:
+        return false;
+    case 1:
+        return true;
+    case 3:
+        return !on;
+    default:
+        return on;
+    }
+}
+
+// Dump the visible image as a plain (ASCII) PBM, 1 = dark pixel
+bool Pcd8544SavePbm(const Pcd8544 *lcd, const char *path)
+{
+    int x;
+    int y;
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+    {
+        return false;
+    }
+    fprintf(file, "P1\n%d %d\n", PCD8544_WIDTH, PCD8544_HEIGHT);
+    for (y = 0; y < PCD8544_HEIGHT; y++)
+    {
+        for (x = 0; x < PCD8544_WIDTH; x++)
+        {
+            fputc(Pcd8544Pixel(lcd, x, y) ? '1' : '0', file);
+        }
+        fputc('\n', file);
+    }
+    return fclose(file) == 0;
+}
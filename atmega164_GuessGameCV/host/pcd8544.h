@@ -0,0 +1,40 @@
+/*
+ * pcd8544.h
+ *
+ * Software model of the PCD8544 controller. It decodes the command/data
+ * byte stream the firmware sends and keeps the 84x48 display RAM.
+ */
+
+#ifndef PCD8544_H_
+#define PCD8544_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PCD8544_WIDTH  84
+#define PCD8544_BANKS  6
+#define PCD8544_HEIGHT (PCD8544_BANKS * 8)
+
+typedef struct
+{
+    uint8_t ram[PCD8544_BANKS * PCD8544_WIDTH];
+    uint8_t x;
+    uint8_t y;
+    bool extended;          // H: extended instruction set
+    bool vertical;          // V: vertical addressing
+    bool powerDown;         // PD
+    uint8_t displayMode;    // D and E bits of display control (0 = blank, 1 = all on, 2 = normal, 3 = inverse)
+    uint8_t vop;
+    uint8_t bias;
+    uint8_t tempCoefficient;
+    unsigned long dataBytes;
+    unsigned long commandBytes;
+    unsigned long unknownCommands;
+} Pcd8544;
+
+void Pcd8544Reset(Pcd8544 *lcd);
+void Pcd8544Write(Pcd8544 *lcd, bool data, uint8_t byte);
+bool Pcd8544Pixel(const Pcd8544 *lcd, int x, int y);
+bool Pcd8544SavePbm(const Pcd8544 *lcd, const char *path);
+
+#endif /* PCD8544_H_ */
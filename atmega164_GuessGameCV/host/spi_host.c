@@ -0,0 +1,38 @@
+/*
+ * spi_host.c
+ *
+ * Host replacement for spi.c: every byte goes straight to the PCD8544
+ * model, with the CD pin read from the mock PORTB like the real chip does.
+ */
+
+#include "gpio.h"
+#include "spi.h"
+#include "host.h"
+
+Pcd8544 hostLcd;
+int hostSpiPending = 0;
+
+void spiInit()
+{
+}
+
+void spiWait()
+{
+}
+
+void spiWrite(unsigned char data)
+{
+    if ((PORTB & IO_MASK(IO_RST)) == 0)
+    {
+        Pcd8544Reset(&hostLcd);     // RES held low
+        return;
+    }
+    Pcd8544Write(&hostLcd, (PORTB & IO_MASK(IO_CD)) != 0, data);
+}
+
+// The byte arrives at once, the harness runs SPI_STC_vect() later at the real SPI rate
+void spiPut(unsigned char data)
+{
+    spiWrite(data);
+    hostSpiPending = 1;
+}
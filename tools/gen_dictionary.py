@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Pack a plain word list into the PROGMEM dictionary used by the firmware.
+
+Every letter A-Z is stored as a 5 bit code (A = 0), LSB first. Words are
+grouped into buckets by length, so inside a bucket word k starts at bit
+k * 5 * length and no per-word index is needed. The only index is one
+entry per length: the number of the bucket's first word and the byte
+offset where its bits start.
+
+Usage: gen_dictionary.py words.txt dictionary.h
+"""
+
+import sys
+
+WORD_MIN = 2
+WORD_MAX = 16       # Must match WORD_MAX in game.h
+BITS = 5
+
+
+def load(path):
+    words = set()
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            word = line.split('#', 1)[0].strip().upper()
+            if not word:
+                continue
+            if not word.isalpha() or not word.isascii():
+                sys.exit('%s:%d: only the letters A-Z are allowed: %r' % (path, number, word))
+            if not WORD_MIN <= len(word) <= WORD_MAX:
+                sys.exit('%s:%d: words must have %d to %d letters: %r' % (path, number, WORD_MIN, WORD_MAX, word))
+            words.add(word)
+    if not words:
+        sys.exit('%s: no words' % path)
+    if len(words) > 0xFFFF:
+        sys.exit('%s: more than 65535 words' % path)
+    return sorted(words, key=lambda w: (len(w), w))
+
+
+def pack(words):
+    lengths = range(min(map(len, words)), max(map(len, words)) + 1)
+    data = bytearray()
+    first = []
+    offset = []
+    index = 0
+    for length in lengths:
+        bucket = [w for w in words if len(w) == length]
+        first.append(index)
+        offset.append(len(data))
+        bits = 0
+        nbits = 0
+        for word in bucket:
+            for letter in word:
+                bits |= (ord(letter) - ord('A')) << nbits
+                nbits += BITS
+        data += bits.to_bytes((nbits + 7) // 8, 'little')
+        index += len(bucket)
+    # Sentinel entries so the size of bucket n is first[n + 1] - first[n]
+    first.append(index)
+    offset.append(len(data))
+    if len(data) > 0xFFFF:
+        sys.exit('packed dictionary is larger than 64 KB')
+    return lengths, first, offset, data
+
+
+def table(values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt % v for v in values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def render(source, words, lengths, first, offset, data):
+    plain = sum(len(w) + 1 for w in words)
+    return '''/*
+ * Generated by tools/gen_dictionary.py from %(source)s, do not edit.
+ *
+ * %(count)d words, %(size)d bytes packed + %(index)d bytes index (%(plain)d bytes as C strings)
+ */
+
+#ifndef DICTIONARY_H_
+#define DICTIONARY_H_
+
+#define DICT_WORD_COUNT %(count)d
+#define DICT_LENGTH_MIN %(lmin)d
+#define DICT_LENGTH_MAX %(lmax)d
+
+// Number of the first word of each length (DICT_LENGTH_MIN first, then a sentinel)
+const PROGMEM unsigned int DICT_BUCKET_FIRST[] = {
+%(first)s
+};
+
+// Byte offset in DICT_DATA where the words of each length start (then a sentinel)
+const PROGMEM unsigned int DICT_BUCKET_OFFSET[] = {
+%(offset)s
+};
+
+// 5 bit letter codes (A = 0), LSB first, one bucket after the other
+const PROGMEM unsigned char DICT_DATA[] = {
+%(data)s
+};
+
+#endif /* DICTIONARY_H_ */
+''' % {
+        'source': source,
+        'count': len(words),
+        'size': len(data),
+        'index': 4 * len(first),
+        'plain': plain,
+        'lmin': lengths.start,
+        'lmax': lengths.stop - 1,
+        'first': table(first, 8, '%5d'),
+        'offset': table(offset, 8, '%5d'),
+        'data': table(list(data), 12, '0x%02x'),
+    }
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__.strip().splitlines()[-1])
+    source, target = sys.argv[1], sys.argv[2]
+    words = load(source)
+    text = render(source.replace('\\', '/').split('/')[-1], words, *pack(words))
+    text = text.replace('\n', '\r\n')      # Same line endings as the rest of the Atmel Studio project
+    try:
+        with open(target, newline='') as f:
+            if f.read() == text:
+                return      # Unchanged, keep the timestamp so nothing rebuilds
+    except OSError:
+        pass
+    with open(target, 'w', newline='') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main()